@@ -10,6 +10,7 @@ C_SRCS += \
 ../src/delay.c \
 ../src/lcd_object.c \
 ../src/main.c \
+../src/stm32f10x_dma.c \
 ../src/stm32f10x_fsmc.c \
 ../src/stm32f10x_usart.c \
 ../src/uart_object.c 
@@ -21,6 +22,7 @@ OBJS += \
 ./src/delay.o \
 ./src/lcd_object.o \
 ./src/main.o \
+./src/stm32f10x_dma.o \
 ./src/stm32f10x_fsmc.o \
 ./src/stm32f10x_usart.o \
 ./src/uart_object.o 
@@ -32,6 +34,7 @@ C_DEPS += \
 ./src/delay.d \
 ./src/lcd_object.d \
 ./src/main.d \
+./src/stm32f10x_dma.d \
 ./src/stm32f10x_fsmc.d \
 ./src/stm32f10x_usart.d \
 ./src/uart_object.d 
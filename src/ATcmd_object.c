@@ -69,6 +69,34 @@ static const unsigned char ATcmd[MAX_ATCMD_NUM][6] =
     "AT+gX", /* Get Font Xsize        */
     "AT+gY", /* Get Font Ysize        */
     "AT+dB", /* Draw Bitmap           */
+    "AT+gS", /* Get Statistics        */
+    "AT+tm", /* Set Text Mode         */
+    "AT+ts", /* Text Slot             */
+    "AT+CM", /* Console Mode          */
+    "AT+ch", /* Set Chart             */
+    "AT+cd", /* Chart Data            */
+    "AT+BF", /* Begin Frame           */
+    "AT+EF", /* End Frame             */
+    "AT+wc", /* Widget Create         */
+    "AT+ws", /* Widget Set            */
+    "AT+wd", /* Widget Delete         */
+    "AT+cp", /* Clip Push             */
+    "AT+cP", /* Clip Pop              */
+    "AT+fp", /* Fill Polygon          */
+    "AT+ft", /* Fill Triangle         */
+    "AT+de", /* Draw Ellipse          */
+    "AT+fe", /* Fill Ellipse          */
+    "AT+da", /* Draw Arc              */
+    "AT+fa", /* Fill Arc (pie slice)  */
+    "AT+qb", /* Quadratic Bezier      */
+    "AT+cb", /* Cubic Bezier          */
+    "AT+st", /* Set stroke style      */
+    "AT+aa", /* Anti-aliased strokes  */
+    "AT+gr", /* Gradient rectangle    */
+    "AT+pb", /* Select pattern brush  */
+    "AT+pu", /* Upload pattern brush  */
+    "AT+rp", /* Read back pixels      */
+    "AT+cy", /* Copy rectangle        */
 
     "AT+DT", /* Data */
     "AT+ED", /* End  */
@@ -119,6 +147,24 @@ static void clean_cmd_buf(object_ATcmd *at_cmd)
   at_cmd->command.status = not_start;
 }
 
+/**
+********************************************************************************
+* @function  void pass_to_console(object_ATcmd *at_cmd,int c)
+* @brief     The characters in the command buffer and 'c' are not the start
+*            of a command ,give them to the LCD console and clean the buffer.
+*            When console mode is off ,they are dropped.
+********************************************************************************
+**/
+static void pass_to_console(object_ATcmd *at_cmd,int c)
+{
+  unsigned int count;
+  for(count = 0; count < at_cmd->command.new_position; count++)
+    {
+      global_lcd.console_putc(at_cmd->command.buf[count]);
+    }
+  global_lcd.console_putc((unsigned char)c);
+  clean_cmd_buf(at_cmd);
+}
 
 /**
 ********************************************************************************
@@ -129,6 +175,7 @@ static void clean_cmd_buf(object_ATcmd *at_cmd)
 *            Between the start and the end,
 *            the characters '\0' '\n' are ignored.
 *            Only one command can be in the command buffer at one time.
+*            Characters out of commands go to the LCD console.
 * @return    0  --> succeed
 *            -1 --> fail (wrong or incomplete command)
 ********************************************************************************
@@ -160,7 +207,7 @@ static int get_a_cmd(object_ATcmd *at_cmd)
 		}
 	      else
 		{
-		  clean_cmd_buf(at_cmd);   /* no "AT" , clean the 'A'*/
+		  pass_to_console(at_cmd,c);   /* no "AT" , clean the 'A'*/
 		  return -1;
 		}
 	      break;
@@ -173,12 +220,12 @@ static int get_a_cmd(object_ATcmd *at_cmd)
 		}
 	      else
 		{
-		  clean_cmd_buf(at_cmd);  /* no "AT+" , clean the "AT" */
+		  pass_to_console(at_cmd,c);  /* no "AT+" , clean the "AT" */
 		  return -1;
 		}
 	      break;
 	    default :
-	      clean_cmd_buf(at_cmd); /* no "A" "T" "+" , clean the buffer */
+	      pass_to_console(at_cmd,c); /* no "A" "T" "+" , clean the buffer */
 	      return -1;
 	    }
 	}
@@ -252,7 +299,8 @@ static int get_cmd_index(object_ATcmd *at_cmd)
 * @function  int get_cmd_param(object_ATcmd *at_cmd,unsigned char **args)
 * @brief     Get the command paramters.
 *            '=' starts the first parameter.
-* @return    count  --> the parameter numbers [0-6]
+*            'args' has room for MAX_ATCMD_PARAM + 1 pointers.
+* @return    count  --> the parameter numbers [0-MAX_ATCMD_PARAM]
 *            -1 --> fail
 ********************************************************************************
 **/
@@ -286,6 +334,10 @@ static int get_cmd_param(object_ATcmd *at_cmd,char **args)
   while(*(args+count) != NULL)
     {
       count++;
+      if(count > MAX_ATCMD_PARAM)  /* too many parameters */
+	{
+	  return -1;
+	}
       *(args+count) = strtok( NULL, delim1);
     }
 
@@ -316,7 +368,7 @@ static int execute_a_cmd(object_ATcmd *at_cmd)
    **************************************************/
   int ATcmd_index;
   int arg_num;
-  char *args[6];
+  char *args[MAX_ATCMD_PARAM + 1];
 
   if(at_cmd->command.status == complete)
     {
@@ -480,6 +532,34 @@ int object_ATcmd_init(object_ATcmd * at_cmd)
   at_cmd->action_array[count++] = global_lcd.get_font_Xsize;
   at_cmd->action_array[count++] = global_lcd.get_font_Ysize;
   at_cmd->action_array[count++] = global_lcd.draw_bitmap;
+  at_cmd->action_array[count++] = global_lcd.get_statistics;
+  at_cmd->action_array[count++] = global_lcd.set_text_mode;
+  at_cmd->action_array[count++] = global_lcd.text_slot;
+  at_cmd->action_array[count++] = global_lcd.console_mode;
+  at_cmd->action_array[count++] = global_lcd.set_chart;
+  at_cmd->action_array[count++] = global_lcd.chart_data;
+  at_cmd->action_array[count++] = global_lcd.begin_frame;
+  at_cmd->action_array[count++] = global_lcd.end_frame;
+  at_cmd->action_array[count++] = global_lcd.widget_create;
+  at_cmd->action_array[count++] = global_lcd.widget_set;
+  at_cmd->action_array[count++] = global_lcd.widget_delete;
+  at_cmd->action_array[count++] = global_lcd.clip_push;
+  at_cmd->action_array[count++] = global_lcd.clip_pop;
+  at_cmd->action_array[count++] = global_lcd.fill_polygon;
+  at_cmd->action_array[count++] = global_lcd.fill_triangle;
+  at_cmd->action_array[count++] = global_lcd.draw_ellipse;
+  at_cmd->action_array[count++] = global_lcd.fill_ellipse;
+  at_cmd->action_array[count++] = global_lcd.draw_arc;
+  at_cmd->action_array[count++] = global_lcd.fill_arc;
+  at_cmd->action_array[count++] = global_lcd.quad_bezier;
+  at_cmd->action_array[count++] = global_lcd.cubic_bezier;
+  at_cmd->action_array[count++] = global_lcd.set_stroke;
+  at_cmd->action_array[count++] = global_lcd.anti_alias;
+  at_cmd->action_array[count++] = global_lcd.fill_gradient;
+  at_cmd->action_array[count++] = global_lcd.set_brush;
+  at_cmd->action_array[count++] = global_lcd.upload_brush;
+  at_cmd->action_array[count++] = global_lcd.read_pixels;
+  at_cmd->action_array[count++] = global_lcd.copy_rect;
     /*other functions*/
   while(count < MAX_ATCMD_NUM - 1)
     {
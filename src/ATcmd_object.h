@@ -21,7 +21,18 @@
 ********************************************************************************
 **/
 
-#define MAX_ATCMD_NUM 38  
+#define MAX_ATCMD_NUM 66  
+
+/**
+********************************************************************************
+* @Micro  MAX_ATCMD_PARAM
+* @brief  Max parameter number in one command.
+*         AT+fp takes a fill rule and up to 16 vertices (x ,y).
+*         A command with more parameters is refused.
+********************************************************************************
+**/
+
+#define MAX_ATCMD_PARAM 33
 
 /**
 ********************************************************************************
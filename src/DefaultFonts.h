@@ -4,6 +4,10 @@
 #define PROGMEM
 #define fontdatatype const unsigned char
 
+/* Font data is word aligned ,so the glyph expander can read it 4 bytes
+   at a time (every glyph size in these fonts is a multiple of 4). */
+#define FONT_ALIGN __attribute__((aligned(4)))
+
 extern fontdatatype SmallFont[1144];
 extern fontdatatype BigFont[3044];
 extern fontdatatype SevenSegNumFont[2004];
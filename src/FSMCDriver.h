@@ -1,6 +1,6 @@
-#ifndef __FSMCDRIVER
-#define __FSMCDRIVER
-
-extern void FSMC_Init(void);
-
-#endif
+#ifndef __FSMCDRIVER
+#define __FSMCDRIVER
+
+extern void FSMC_Init(void);
+
+#endif
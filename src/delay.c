@@ -1,47 +1,59 @@
-#include <stm32f10x.h>
-#include "delay.h"
-
-static __IO uint32_t TimingDelay;
-
-
-void Systick_Init(void)
-{
-	if (SysTick_Config(SystemCoreClock / 1000))
-	{ 
-		/* Capture error */ 
-		while (1);
-	}
-}
-
-/**
-  * @brief  Inserts a delay time.
-  * @param  nTime: specifies the delay time length, in milliseconds.
-  * @retval None
-  */
-void Delayms(__IO uint32_t nTime)
-{ 
-  TimingDelay = nTime;
-
-  while(TimingDelay != 0);
-}
-
-/**
-  * @brief  Decrements the TimingDelay variable.
-  * @param  None
-  * @retval None
-  */
-void TimingDelay_Decrement(void)
-{
-  if (TimingDelay != 0x00)
-  { 
-    TimingDelay--;
-  }
-}
- 
-
- 
-void SysTick_Handler(void)
-{
-  TimingDelay_Decrement();
-}
-
+#include <stm32f10x.h>
+#include "delay.h"
+
+static __IO uint32_t TimingDelay;
+static __IO uint32_t TickCount;
+
+
+void Systick_Init(void)
+{
+	if (SysTick_Config(SystemCoreClock / 1000))
+	{ 
+		/* Capture error */ 
+		while (1);
+	}
+}
+
+/**
+  * @brief  Inserts a delay time.
+  * @param  nTime: specifies the delay time length, in milliseconds.
+  * @retval None
+  */
+void Delayms(__IO uint32_t nTime)
+{ 
+  TimingDelay = nTime;
+
+  while(TimingDelay != 0);
+}
+
+/**
+  * @brief  Decrements the TimingDelay variable.
+  * @param  None
+  * @retval None
+  */
+void TimingDelay_Decrement(void)
+{
+  if (TimingDelay != 0x00)
+  { 
+    TimingDelay--;
+  }
+}
+ 
+
+ 
+/**
+  * @brief  Gets the milliseconds since Systick_Init.
+  * @param  None
+  * @retval The millisecond counter ,it wraps around after 49 days.
+  */
+uint32_t GetTickms(void)
+{
+  return TickCount;
+}
+
+void SysTick_Handler(void)
+{
+  TickCount++;
+  TimingDelay_Decrement();
+}
+
@@ -1,8 +1,9 @@
-#ifndef __DELAY
-#define __DELAY
-
-#include<stm32f10x.h>
-
-extern void Delayms(__IO uint32_t nTime);
-
-#endif
+#ifndef __DELAY
+#define __DELAY
+
+#include<stm32f10x.h>
+
+extern void Delayms(__IO uint32_t nTime);
+extern uint32_t GetTickms(void);
+
+#endif
@@ -1,1675 +1,8918 @@
-/**
-********************************************************************************
-* @file     lcd_object.c
-* @author   
-* @version  v0.1
-* @date     2014.11.27
-* @brief    This file contains all functions that support object_lcd interface
-*           Note: some functions need initialized global 'usart1'
-********************************************************************************
-**/
-
-#include <string.h>      /* strncmp() */
-#include <stm32f10x.h>   /* gpio functions */
-#include "delay.h"       /* Delayms(__IO uint32_t nTime) */
-#include "FSMCDriver.h"  /* FSMC_Init() */
-#include "uart_object.h" /* object_uart interface & global 'usart1' */
-#include "lcd_object.h"  /* object_lcd interface */
-#include "DefaultFonts.h"
-
-
-/**
-********************************************************************************
-* @array    lcd_index[]
-* @brief    LCD type index.
-*           LCD in this array can be used.
-********************************************************************************
-**/
-
-struct _lcd_type 
-{
-  const char name[8];
-  unsigned int x_size;
-  unsigned int y_size;
-};
-
-#define MAX_LCD_INDEX_NUM 1
-
-static const struct _lcd_type lcd_index[] =
-  {
-    { "HX8347A", 240 , 320}    /* HX8347A , Xsize = 240 ,Ysize = 320*/
-  };
-
-
-/**
-********************************************************************************
-* @variable front_color , back_color
-*           display_x , display_y
-*           cfont
-* @brief    Global LCD information variables in this file. (Only in this file)
-*           front_color  --> color for drawn area, 0~65535 
-*           back_color   --> color for blank area, 0~65525
-*           display_x    --> the max x_size of the current LCD
-*           display_y    --> the max y_size of the current LCD
-*           cfont        --> the current font to be used
-********************************************************************************
-**/
-
-static unsigned int front_color = 0,back_color = 65535;
-static unsigned int display_x = 0;
-static unsigned int display_y = 0;
-
-struct _current_font
-{
-  const unsigned char *font; /* font name in file 'DefaultFonts.h' */
-  unsigned int x_size;       /* font Xsize */
-  unsigned int y_size;       /* font Ysize */
-  unsigned int offset;       /* used to calculate the location of a character */
-  unsigned int numchars;     /* characters' number in current font array */
-};
-
-static struct _current_font cfont = {SmallFont , 0x08, 0x0c, 0x20, 0x5f};  
-
-
-/**
-********************************************************************************
-* @micro    Bank1_LCD_D 
-*           Bank1_LCD_C 
-* @brief    Hardware related :
-*           GPIO PD2 --> LCD_RST
-*           GPIO PD3 --> LCD_ON
-*           STM32F103F use "FSMC" to communicate with LCD controller.
-*           In this way ,the LCD Data_addr is link to memory_addr 0x60020000
-*           the LCD Reg_addr is link to memory_addr 0x60000000
-********************************************************************************
-**/
-#define Bank1_LCD_D    ((uint32_t)0x60020000)    //disp Data ADDR
-#define Bank1_LCD_C    ((uint32_t)0x60000000)    //disp Reg ADDR
-
-
-/**
-********************************************************************************
-* @function  unsigned int RGB_to_color(int r ,int g ,int b)
-* @brief     translate (RGB) data to (unsigned int) data.
-*            RGB 16bit: R(5)G(6)B(5)
-********************************************************************************
-**/
-static unsigned int RGB_to_color(unsigned int r ,unsigned int g ,unsigned int b)
-{
-  unsigned int color;  
-  color =  (r & 248) <<8 | (g & 252) <<3 | (b & 248) >>3;
-  return color;
-}
-
-
-/**
-********************************************************************************
-* @function  void Write_Command(unsigned int index)
-* @brief     Send a value to LCD Reg_Address
-********************************************************************************
-**/
-static void Write_Command(unsigned int index)
-{
-    *(__IO uint16_t *) (Bank1_LCD_C)= index;
-}
-
-/**
-********************************************************************************
-* @function  void Write_Command_Data(unsigned int index,unsigned int val)
-* @brief     Send a value to LCD Reg_Address and follow a data to Data_Address
-********************************************************************************
-**/
-static void Write_Command_Data(unsigned int index,unsigned int val)
-{
-  *(__IO uint16_t *) (Bank1_LCD_C)= index;
-  *(__IO uint16_t *) (Bank1_LCD_D)= val;
-
-}
-
-/**
-********************************************************************************
-* @function  void  Write_Data(unsigned int val)
-* @brief     Send a value to LCD Data_Address
-********************************************************************************
-**/
-static void  Write_Data(unsigned int val)
-{   
-  *(__IO uint16_t *) (Bank1_LCD_D)= val;
-
-}
-
-/**
-********************************************************************************
-* @function  unsigned int str_to_uint(unsigned char *str)
-* @brief     Change a string to integer. Like " int atoi(const char*) "
-*            For example :
-*             str=" 1 2 3" --> (int)num=str_to_uint(str) --> num = 123
-*            Note: only string like "0123 456789" can be transformed.[123456789]
-* @return    num --> transformed integer 
-********************************************************************************
-**/
-
-static unsigned int str_to_uint(unsigned char *str)
-{
-  unsigned int num;
-
-  unsigned char *p;
-  p = str;
-  num = 0;
-  while(*p != '\0')
-  {
-	  if( *p > '/' && *p < ':') /* *p = '0' ~ '9' */
-	  {
-		  num = (num << 3) + (num << 1) + *p - '0'; /* num = num * 10 + next_bit*/
-	  }
-
-    p++;
-  }
-  return num;
-}
-
-
-/**
-********************************************************************************
-* @function  void SetXY(unsigned int x0,unsigned int y0,
-*	                unsigned int x1,unsigned int y1)
-* @brief     Set an area to be drawn.
-********************************************************************************
-**/
-static void SetXY(unsigned int x0,unsigned int y0,
-		  unsigned int x1,unsigned int y1)
-{
-
-  Write_Command_Data(0x0044,(x1 << 8) + x0);
-  Write_Command_Data(0x0045,y0);
-  Write_Command_Data(0x0046,y1);
-  Write_Command_Data(0x004e,x0);
-  Write_Command_Data(0x004f,y0);
-  Write_Command (0x0022);//LCD_WriteCMD(GRAMWR);
-}
-
-
-/**
-********************************************************************************
-* @function  void LCD_Init(unsigned char **args, int arg_num)
-* @brief     Initialize LCD (HX8347A) ,ignore 'args' 
-********************************************************************************
-**/
-static void LCD_Init_hx8347a(unsigned char **args, int arg_num)
-{
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-  unsigned char *p = *args;
-  if(arg_num != 0) /* This function does not need parameters */
-    {
-      p++;
-      return ;
-    }
-
-  GPIO_ResetBits(GPIOD, GPIO_Pin_2);
-  Delayms(4);					   
-  GPIO_SetBits(GPIOD, GPIO_Pin_2 );		 	 
-  Delayms(10);
-
-  Write_Command_Data(0x0000,0x0001);
-  Write_Command_Data(0x0003,0xA8A4);
-  Write_Command_Data(0x000C,0x0000);
-  Write_Command_Data(0x000D,0x080C);
-  Write_Command_Data(0x000E,0x2B00);
-  Write_Command_Data(0x001E,0x00B7);
-  Write_Command_Data(0x0001,0x2B3F);
-  Write_Command_Data(0x0002,0x0600);
-  Write_Command_Data(0x0010,0x0000);
-  Write_Command_Data(0x0011,0x6070);
-  Write_Command_Data(0x0005,0x0000);
-  Write_Command_Data(0x0006,0x0000);
-  Write_Command_Data(0x0016,0xEF1C);
-  Write_Command_Data(0x0017,0x0003);
-  Write_Command_Data(0x0007,0x0233);
-  Write_Command_Data(0x000B,0x0000);
-  Write_Command_Data(0x000F,0x0000);
-  Write_Command_Data(0x0041,0x0000);
-  Write_Command_Data(0x0042,0x0000);
-  Write_Command_Data(0x0048,0x0000);
-  Write_Command_Data(0x0049,0x013F);
-  Write_Command_Data(0x004A,0x0000);
-  Write_Command_Data(0x004B,0x0000);
-  Write_Command_Data(0x0044,0xEF00);
-  Write_Command_Data(0x0045,0x0000);
-  Write_Command_Data(0x0046,0x013F);
-  Write_Command_Data(0x0030,0x0707);
-  Write_Command_Data(0x0031,0x0204);
-  Write_Command_Data(0x0032,0x0204);
-  Write_Command_Data(0x0033,0x0502);
-  Write_Command_Data(0x0034,0x0507);
-  Write_Command_Data(0x0035,0x0204);
-  Write_Command_Data(0x0036,0x0204);
-  Write_Command_Data(0x0037,0x0502);
-  Write_Command_Data(0x003A,0x0302);
-  Write_Command_Data(0x003B,0x0302);
-  Write_Command_Data(0x0023,0x0000);
-  Write_Command_Data(0x0024,0x0000);
-  Write_Command_Data(0x0025,0x8000);
-  Write_Command_Data(0x004f,0x0000);
-  Write_Command_Data(0x004e,0x0000);
-  Write_Command(0x0022);
- if(usart1.debug == 1)
-   {
-     usart1.printf(&usart1,"LCD is initialized.\n");
-   }
-}
-
-
-
-/**
-********************************************************************************
-* @function  void FillScreen(unsigned char **args, int arg_num)
-* @brief     Fill the LCD screen with the color passed by the parameter 'args'.
-********************************************************************************
-**/
-static void FillScreen(unsigned char **args, int arg_num)
-{
-  unsigned int i,j;
-  unsigned int tmp[3];  /* store the color or RGB data*/
-  unsigned int color;
-
-  switch(arg_num)  /* set color ,depends on arg_num*/
-    {
-    case 1:        /* 1 parameter --> color */
-      tmp[0] = str_to_uint(*args); /* change string to integer */
-      color  = tmp[0];
-      break;
-    case 3:        /* 3 parameters , RGB data --> color */
-      for(i = 0 ; i < 3 ; i++)
-	{
-	  tmp[i] = str_to_uint(*(args + i));
-	}
-      color = RGB_to_color(tmp[0],tmp[1],tmp[2]);
-      break;
-    case 0:        /* no parameter , set default value */
-    default:       /* wrong parameters , set default value */
-      color = back_color;
-      break;
-    }
-
-  SetXY(0, 0, display_x - 1, display_y - 1);
-
-  for(i = 0; i < display_y; i++)
-    {
-      for (j = 0; j < display_x; j++)
-	{
-	  Write_Data(color);
-	}
-
-    }		
-}
-
-/**
-********************************************************************************
-* @function  void ClearScreen(unsigned char **args, int arg_num)
-* @brief     Fill the LCD screen with the back_color.
-********************************************************************************
-**/
-static void ClearScreen(unsigned char **args, int arg_num)
-{
-  unsigned int i,j;
-
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++;
-      return ;
-    }
-  SetXY(0, 0, display_x - 1, display_y - 1);
-
-  for(i = 0; i < display_y; i++)
-    {
-      for (j = 0; j < display_x; j++)
-	{
-	  Write_Data(back_color);
-	}
-    }		
-}
-
-
-/**
-********************************************************************************
-* @function  void SetFrontColor(unsigned char **args, int arg_num)
-* @brief     Front Color is used for area to be drawn.
-********************************************************************************
-**/
-static void SetFrontColor(unsigned char **args, int arg_num)
-{
-  unsigned int color_r,color_g,color_b;
-
-  switch(arg_num) /* set front_color ,depends on args */
-    {
-    case 1:  /* 1 parameters */
-      front_color = str_to_uint(*args);
-      break;
-    case 3: /* 3 parameters , RGB */
-      color_r = str_to_uint(*args);
-      color_g = str_to_uint(*(args+1));
-      color_b = str_to_uint(*(args+2));
-      front_color = RGB_to_color(color_r,color_g,color_b);
-      break;
-    default:
-      break;
-    }
-}
-
-
-/**
-********************************************************************************
-* @function  void GetFrontColor(unsigned char **args, int arg_num)
-* @brief     print the front_color to the usart1.
-********************************************************************************
-**/
-static void GetFrontColor_uart1(unsigned char **args, int arg_num)
-{
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++;
-      return;
-    }
-  usart1.printf(&usart1,"front_color is %d\n",front_color);
-}
-
-
-/**
-********************************************************************************
-* @function  void SetBackColor(unsigned char **args, int arg_num)
-* @brief     Back color is for blank area.
-********************************************************************************
-**/
-static void SetBackColor(unsigned char **args, int arg_num)
-{
-  unsigned int color_r,color_g,color_b;
-
-  switch(arg_num) /* set back_color ,depends on args */
-    {
-    case 1:  /* 1 parameters */
-      back_color = str_to_uint(*args);
-      break;
-    case 3: /* 3 parameters , RGB */
-      color_r = str_to_uint(*args);
-      color_g = str_to_uint(*(args+1));
-      color_b = str_to_uint(*(args+2));
-      back_color = RGB_to_color(color_r,color_g,color_b);
-      break;
-    default:
-      break;      
-    }
-}
-
-/**
-********************************************************************************
-* @function  void GetBackColor(unsigned char **args, int arg_num)
-* @brief     print the back_color to the usart1.
-********************************************************************************
-**/
-static void GetBackColor_uart1(unsigned char **args, int arg_num)
-{
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++;
-      return;
-    }
-  usart1.printf(&usart1,"back_color is %d\n",back_color);
-}
-
-/**
-********************************************************************************
-* @function  void _DrawPoint(unsigned int x,unsigned int y)
-* @brief     Draw a point.
-********************************************************************************
-**/
-static void _DrawPoint(unsigned int x,unsigned int y)
-{
-  SetXY(x, y, x, y);
-  Write_Data(front_color);
-}
-
-/**
-********************************************************************************
-* @function  void DrawPoint(unsigned char **args ,int arg_num)
-* @brief     Get the point location and call the _DrawPoint.
-********************************************************************************
-**/
-static void DrawPoint(unsigned char **args ,int arg_num)
-{
-  unsigned int x,y;
-  if(arg_num == 2)
-    {
-      x = str_to_uint(*args);
-      y = str_to_uint(*(args + 1));
-      if(x < display_x && y < display_y)
-	{
-	  _DrawPoint(x , y);
-	}
-    }
-}
-
-/**
-********************************************************************************
-* @function  static void _DrawLine_H(unsigned int x0, unsigned int y0 ,
-*			             unsigned int x1 ,unsigned int y1)
-* @brief     Draw a horizontal line.
-********************************************************************************
-**/
-static void _DrawLine_H(unsigned int x0, unsigned int y0 ,
-			unsigned int x1 ,unsigned int y1)
-{
-  unsigned int i ,l;
-  /* variable p is only used to avoid warning 'unused parameter'*/
-  unsigned int p = y1;
-  p++;
-
-  if(x0 > x1)
-    {
-      SetXY(x1,y0,x0,y0);
-      l = x0 -x1;
-    }
-  else
-    {
-      SetXY(x0,y0,x1,y0);
-      l = x1 - x0;
-    }
-
-  for(i = 0; i < l; i++)
-    {
-      Write_Data(front_color);
-    }
-
-}
-
-/**
-********************************************************************************
-* @function  _DrawLine_V(unsigned int x0, unsigned int y0 ,
-			unsigned int x1 ,unsigned int y1)
-* @brief     Draw a vertical line.
-********************************************************************************
-**/
-static void _DrawLine_V(unsigned int x0, unsigned int y0 ,
-			unsigned int x1 ,unsigned int y1)
-{
-  unsigned int i,l;
-  /* variable p is only used to avoid warning 'unused parameter'*/
-  unsigned int p = x1;
-  p++;
-
-  if(y0 > y1)
-    {
-      SetXY(x0,y1,x0,y0);      
-      l = y0 - y1;
-    }
-  else
-    {
-      SetXY(x0,y0,x0,y1);      
-      l = y1 - y0;
-    }
-
-  for(i = 0; i < l; i++)
-    {
-      Write_Data(front_color);
-    }
-}
-
-/**
-********************************************************************************
-* @function  void _DrawLine_A(unsigned int x0, unsigned int y0 ,
-*                	       unsigned int x1 ,unsigned int y1)
-* @brief     Draw an ablique line.
-********************************************************************************
-**/
-static void _DrawLine_A(unsigned int x0, unsigned int y0 ,
-			unsigned int x1 ,unsigned int y1)
-{
-  int i, delta_x, delta_y, numpixels, d, dinc1, dinc2,
-    x, xinc1, xinc2, y, yinc1, yinc2;
-    
-  /* Calculate delta-x and delta-y for initialization */
-  delta_x = (x1 > x0)?(x1 - x0):(x0 - x1);
-  delta_y = (y1 > y0)?(y1 - y0):(y0 - y1);
-
-  /* Initialize all vars based on which is the independent variable */ 
-  if(delta_x >= delta_y)
-    {
-      /* x is independent variable */
-      numpixels = delta_x + 1;
-      d = (delta_y << 1) - delta_x;
-      dinc1 = delta_y << 1;
-      dinc2 = (delta_y - delta_x) << 1;
-      xinc1 = 1;
-      xinc2 = 1;
-      yinc1 = 0;
-      yinc2 = 1;
-    }
-  else
-    {
-      /* y is independent variable */ 
-      numpixels = delta_y + 1;
-      d = (delta_x << 1) - delta_y;
-      dinc1 = delta_x << 1;
-      dinc2 = (delta_x - delta_y) << 1;
-      xinc1 = 0;
-      xinc2 = 1;
-      yinc1 = 1;
-      yinc2 = 1;
-    }
-  // Make sure x and y move in the right directions
-  //
-  if(x0 > x1)
-    {
-      xinc1 = - xinc1;
-      xinc2 = - xinc2;
-    }
-  if(y0 > y1)
-    {
-      yinc1 = - yinc1;
-      yinc2 = - yinc2;
-    }
-
-  // Start drawing at <x1, y1>
-  //
-  x = x0;
-  y = y0;
-  // Draw the points
-  //
-  for(i= 1; i< numpixels;i++)
-    {
-      SetXY(x,y,x,y);
-      Write_Data(front_color);
-      if (d < 0)
-	{
-	  d = d + dinc1;
-	  x = x + xinc1;
-	  y = y + yinc1;
-	}
-      else
-	{
-	  d = d + dinc2;
-	  x = x + xinc2;
-	  y = y + yinc2;
-	}
-    }
-}
-
-/**
-********************************************************************************
-* @function  void void _TestDrawLine()
-* @brief     print some lines on the screen.
-********************************************************************************
-**/
-static void _TestDrawLine(void)
-{
-  unsigned int location = 20;
-
-  _DrawLine_H(20,150,220,150);
-  _DrawLine_V(120,10,120,310);
-  while(location < display_y)
-    {
-      _DrawLine_A(20,150,120,location);
-      location += 25;
-    }
-}
-
-
-/**
-********************************************************************************
-* @function  void DrawLine(unsigned char **args ,int arg_num)
-* @brief     Get the line parameters and call the draw_line functions.
-********************************************************************************
-**/
-static void DrawLine(unsigned char **args ,int arg_num)
-{
-  unsigned int location[4] ,count;
-  
-  if(arg_num != 4)
-    {
-#ifdef LCD_DEBUG
-      if(arg_num == 0)
-	{
-	  _TestDrawLine();
-	  return;
-	}
-#endif
-      return;      
-    }
-
-  for(count = 0 ;count < 4; count++)
-    {
-      location[count] = str_to_uint(*(args + count));
-    }
-
-  /* location out of range ,return*/
-  if(location[0] >= display_x || location[2] >= display_x ||
-     location[1] >= display_y || location[3] >= display_y)
-    {
-      return ;
-    }
-
-  if(location[0] == location[2])    /* Draw a vertical line.*/
-    {
-      _DrawLine_V(location[0],location[1],location[2],location[3]);
-    }
-  else if(location[1] == location[3])    /* Draw a horizontal line.*/
-    {
-      _DrawLine_H(location[0],location[1],location[2],location[3]);
-    }
-  else /* Draw an ablique line.*/
-    {
-      _DrawLine_A(location[0],location[1],location[2],location[3]);
-    }
-}
-
-/**
-********************************************************************************
-* @function  _DrawRectangle(unsigned int x0, unsigned int y0,
-		            unsigned int x1, unsigned int y1)
-* @brief     Draw a Rectangle.
-********************************************************************************
-**/
-static void _DrawRectangle(unsigned int x0, unsigned int y0,
-			   unsigned int x1, unsigned int y1)
-{
-  _DrawLine_H(x0 ,y0 ,x1 ,y0);
-  _DrawLine_H(x0 ,y1 ,x1 ,y1);
-  _DrawLine_V(x0 ,y0 ,x0 ,y1);
-  _DrawLine_V(x1 ,y0 ,x1 ,y1);
-  _DrawPoint(x1,y1);
-}
-
-/**
-********************************************************************************
-* @function  void _Test_DrawRectangle(void)
-* @brief     print some Rectangles on LCD
-********************************************************************************
-**/
-static void _Test_DrawRectangle(void)
-{
-  unsigned int x0 = 0,y0 = 0 ,x1 = display_x - 1 ,y1 = display_y - 1;
-  
-  while( (x0 < x1) && (y0 < y1) )
-    {
-      _DrawRectangle(x0 ,y0 ,x1 ,y1);
-      x0 += 10;
-      x1 -= 10;
-      y0 += 10;
-      y1 -= 10;
-    }
-}
-
-/**
-********************************************************************************
-* @function  void DrawRectangle(unsigned char **args ,int arg_num)
-* @brief     Get the rectangle parameters and call the _DrawRectangle function
-********************************************************************************
-**/
-static void DrawRectangle(unsigned char **args ,int arg_num)
-{
-  unsigned int location[4] ,count;
-  
-  if(arg_num != 4)
-    {
-#ifdef LCD_DEBUG
-      if(arg_num == 0)
-	{
-	  _Test_DrawRectangle();
-	  return;
-	}
-#endif
-      return;      
-    }
-
-  for(count = 0 ;count < 4; count++)
-    {
-      location[count] = str_to_uint(*(args + count));
-    }
-
-  /* location out of range ,return*/
-  if(location[0] >= display_x || location[2] >= display_x || 
-     location[1] >= display_y || location[3] >= display_y)
-    {
-      return ;
-    }
-
-  _DrawRectangle(location[0],location[1],location[2],location[3]);
-}
-
-
-/**
-********************************************************************************
-* @function  void _Draw_Circle(int x, int y ,int radius)
-* @brief     Draw a circle.
-********************************************************************************
-**/
-static void _Draw_Circle(int x, int y ,int radius)
-{
-  int f = 1 - radius;
-  int ddF_x = 1;
-  int ddF_y = -2 * radius;
-  int x1 = 0;
-  int y1 = radius;
-
-  _DrawPoint( x, y + radius);    
-  _DrawPoint( x, y - radius);    
-  _DrawPoint( x + radius, y);    
-  _DrawPoint( x - radius, y);    
-
-  while(x1 < y1)
-    {
-      if(f >= 0) 
-	{
-	  y1--;
-	  ddF_y += 2;
-	  f += ddF_y;
-	}
-      x1++;
-      ddF_x += 2;
-      f += ddF_x;    
-
-      _DrawPoint( x + x1, y + y1);    
-      _DrawPoint( x - x1, y + y1);    
-      _DrawPoint( x + x1, y - y1);    
-      _DrawPoint( x - x1, y - y1);    
-
-      _DrawPoint( x + y1, y + x1);
-      _DrawPoint( x - y1, y + x1);    
-      _DrawPoint( x + y1, y - x1);    
-      _DrawPoint( x - y1, y - x1);    
-    }
-}
-
-/**
-********************************************************************************
-* @function  _Test_DrawCircle(void)
-* @brief     print some circles on LCD
-********************************************************************************
-**/
-static void _Test_DrawCircle(void)
-{
-  unsigned int x = 120, y = 160 , r = 10;
-  int tmp[4];
-
-
-  tmp[0] = (int) x - (int) r;
-  tmp[1] = (int) x + (int) r;
-  tmp[2] = (int) y - (int) r;
-  tmp[3] = (int) y + (int) r;
-
-  while(tmp[0] >= 0 && tmp[1] < (int)display_x && 
-	tmp[2] >= 0 && tmp[3] < (int)display_y)
-    {
-      _Draw_Circle( x, y, r);
-      r += 10;
-      tmp[0] = (int) x - (int) r;
-      tmp[1] = (int) x + (int) r;
-      tmp[2] = (int) y - (int) r;
-      tmp[3] = (int) y + (int) r;
-    }
-}
-
-/**
-********************************************************************************
-* @function  void DrawCircle(unsigned char **args ,int arg_num)
-* @brief     Get parameters and call the _DrawCircle function
-********************************************************************************
-**/
-static void DrawCircle(unsigned char **args ,int arg_num)
-{
-  int tmp[3]; /* (tmp[0],tmp[1]; r = tmp[2]) */
-  unsigned int count;
-  if(arg_num != 3)
-    {
-#ifdef LCD_DEBUG
-      if(arg_num == 0)
-	{
-	  _Test_DrawCircle();
-	  return;
-	}
-#endif
-      return;      
-    }
-
-  for(count = 0 ;count < 3; count++)
-    {
-      tmp[count] = (int)str_to_uint(*(args + count));
-    }
-
-  /* location out of range ,return*/
-  if(tmp[0] >= (int)display_x || tmp[1] >= (int)display_y ||
-     tmp[0] + tmp[2] >= (int)display_x || 
-     tmp[0] - tmp[2] <  0 || 
-     tmp[1] + tmp[2] >= (int)display_y || 
-     tmp[1] - tmp[2] <  0   )   
-    {
-      return ;
-    }
-  
-  _Draw_Circle(tmp[0], tmp[1], tmp[2]);
-}
-
-/**
-********************************************************************************
-* @function  _DrawRRect(unsigned int x0 ,unsigned int y0 ,
-		       unsigned int x1 ,unsigned int y1 , unsigned int radius)
-* @brief     Draw a round corner rectangle
-********************************************************************************
-**/
-static void _DrawRRect(unsigned int x0 ,unsigned int y0 ,
-		       unsigned int x1 ,unsigned int y1 , unsigned int radius)
-{
-  int f = 1 - (int)radius;
-  int ddF_x = 1;
-  int ddF_y = -2 * (int)radius;
-  int step_x = 0;
-  int step_y = (int)radius;
-  
-  unsigned int x = x0 + radius;
-  unsigned int y = y0 + radius;
-  unsigned int offset_x = x1 - x0 - (radius << 1);
-  unsigned int offset_y = y1 - y0 - (radius << 1);
-
-  while(step_x < step_y)
-    {
-      if(f >= 0) 
-	{
-	  step_y--;
-	  ddF_y += 2;
-	  f += ddF_y;
-	}
-      step_x++;
-      ddF_x += 2;
-      f += ddF_x;    
-
-      _DrawPoint( x - step_x, y - step_y);    
-      _DrawPoint( x - step_x, y + step_y + offset_y);    
-      _DrawPoint( x + step_x + offset_x, y + step_y + offset_y);    
-      _DrawPoint( x + step_x + offset_x, y - step_y);    
-
-      _DrawPoint( x - step_y, y - step_x);    
-      _DrawPoint( x - step_y, y + step_x + offset_y);    
-      _DrawPoint( x + step_y + offset_x, y + step_x + offset_y);
-      _DrawPoint( x + step_y + offset_x, y - step_x);    
-    }
-  _DrawLine_H((x0 + radius), y0, (x1 - radius), y0);
-  _DrawLine_H((x0 + radius), y1, (x1 - radius), y1);
-  _DrawLine_V(x0, (y0 + radius), x0, (y1 - radius));
-  _DrawLine_V(x1, (y0 + radius), x1, (y1 - radius));
-
-}
-
-
-/**
-********************************************************************************
-* @function  void _Test_DrawRoundRect(void)
-* @brief     Draw some round corner rectangles.
-********************************************************************************
-**/
-static void _Test_DrawRoundRect(void)
-{
-  unsigned int x0 = 0,y0 = 0 ,x1 = display_x - 1 ,y1 = display_y - 1;
-  unsigned int radius = 60;
-  while( (x0 < x1) && (y0 < y1) && (radius >= 5))
-    {
-      _DrawRRect(x0 ,y0 ,x1 ,y1, radius);
-      x0 += 10;
-      x1 -= 10;
-      y0 += 10;
-      y1 -= 10;
-      radius = (x1 - x0) >> 2;
-    }
-}
-
-/**
-********************************************************************************
-* @function  void DrawRectangle(unsigned char **args ,int arg_num)
-* @brief     Get parameters and call _DrawRRect functions.
-********************************************************************************
-**/
-static void DrawRoundRect(unsigned char **args ,int arg_num)
-{
-  unsigned int location[5] ,count ,tmp;
-  unsigned int delta_x,delta_y;
-  
-  if(arg_num != 5 && arg_num != 4)
-    {
-#ifdef LCD_DEBUG
-      if(arg_num == 0)
-	{
-	  _Test_DrawRoundRect();
-	  return;
-	}
-#endif
-      return;      
-    }
-
-  for(count = 0 ;count < (unsigned int)arg_num; count++)
-    {
-      location[count] = str_to_uint(*(args + count));
-    }
-
-  /* location out of range. */
-  if(location[0] > display_x || location[2] > display_x || 
-     location[1] > display_y || location[3] > display_y)
-    {
-      return ;
-    }
-
-  if(location[0] > location[2])
-    {
-      tmp = location[0];
-      location[0] = location[2];
-      location[2] = tmp;
-    }
-
-  if(location[1] > location[3])
-    {
-      tmp = location[1];
-      location[1] = location[3];
-      location[3] = tmp;
-    }
-  
-  delta_x = location[2] - location[0];
-  delta_y = location[3] - location[1];
-
-  if(arg_num == 4)
-    {
-      location[4] = (delta_x < delta_y)?(delta_x >> 2):(delta_y >> 2);
-    }
-  else if((location[4] << 1) > delta_x || (location[4] << 1) > delta_y)
-    {
-      return;
-    }
-
-  _DrawRRect(location[0],location[1],location[2],location[3],location[4]);
-}
-
-
-/**
-********************************************************************************
-* @function  void _FillRectangle(unsigned int x0 , unsigned int y0 ,
-*                                unsigned int x1 , unsigned int y1)
-* @brief     Draw a filled Rectangle
-********************************************************************************
-**/
-static void _FillRectangle(unsigned int x0 , unsigned int y0 ,
-			   unsigned int x1 , unsigned int y1)
-{
-  while(y0 <= y1)
-    {
-      _DrawLine_H(x0 ,y0 ,x1 ,y0);
-      y0++;
-    }
-}
-
-/**
-********************************************************************************
-* @function  void FillRectangle(unsigned char **args ,int arg_num)
-* @brief     Get parameters and call the _FillRectagnle function.
-********************************************************************************
-**/
-static void FillRectangle(unsigned char **args ,int arg_num)
-{
-  unsigned int location[4] ,count ,tmp;
-  
-  if(arg_num != 4)
-    {
-      return;      
-    }
-
-  for(count = 0 ;count < 4; count++)
-    {
-      location[count] = str_to_uint(*(args + count));
-    }
-
-  /*location out of range ,return*/
-  if(location[0] > display_x || location[2] > display_x || 
-     location[1] > display_y || location[3] > display_y)
-    {
-      return ;
-    }
-
-  if(location[1] > location[3])
-    {
-      tmp = location[1];
-      location[1] = location[3];
-      location[3] = tmp;
-    }
-
-  _FillRectangle(location[0],location[1],location[2],location[3]);
-}
-
-/**
-********************************************************************************
-* @function  void _Fill_Circle(int x, int y ,int radius)
-* @brief     Draw a filled circle
-********************************************************************************
-**/
-static void _Fill_Circle(int x, int y ,int radius)
-{
-  int f = 1 - radius;
-  int ddF_x = 1;
-  int ddF_y = -2 * radius;
-  int x1 = 0;
-  int y1 = radius;
-
-  _DrawLine_H( (x - radius), y, (x + radius), y);
-  _DrawLine_V( x, (y - radius), x, (y + radius));
-
-  while(x1 < y1)
-    {
-      if(f >= 0) 
-	{
-	  y1--;
-	  ddF_y += 2;
-	  f += ddF_y;
-	}
-      x1++;
-      ddF_x += 2;
-      f += ddF_x;    
-
-      _DrawLine_H( (x - x1), y + y1, (x + x1), y + y1);
-      _DrawLine_H( (x - x1), y - y1, (x + x1), y - y1);
-
-      _DrawLine_H( (x - y1), y + x1, (x + y1), y + x1);
-      _DrawLine_H( (x - y1), y - x1, (x + y1), y - x1);
-
-    }
-}
-
-
-/**
-********************************************************************************
-* @function  void FillCircle(unsigned char **args ,int arg_num)
-* @brief     Get parameters and call the _Fill_Circle function
-********************************************************************************
-**/
-static void FillCircle(unsigned char **args ,int arg_num)
-{
-  int tmp[3] ,count; /* (tmp[0],tmp[1]; r = tmp[2]) */
-
-  if(arg_num != 3)
-    {
-      return;      
-    }
-
-  for(count = 0 ;count < 3; count++)
-    {
-      tmp[count] = (int)str_to_uint(*(args + count));
-    }
-
-  /*location out of range*/
-  if(tmp[0] >= (int)display_x || tmp[1] >= (int)display_y ||
-     tmp[0] + tmp[2] >= (int)display_x || 
-     tmp[0] - tmp[2] <  0   || 
-     tmp[1] + tmp[2] >= (int)display_y || 
-     tmp[1] - tmp[2] <  0   )   
-    {
-      return ;
-    }
-  _Fill_Circle(tmp[0],tmp[1],tmp[2]);
-}
-
-/**
-********************************************************************************
-* @function  _FillRoundRect(unsigned int x0 ,unsigned int y0 ,
-			   unsigned int x1 ,unsigned int y1 , unsigned int radius)
-* @brief     Draw a filled round corner rectangle.
-********************************************************************************
-**/
-static void _FillRoundRect(unsigned int x0 ,unsigned int y0 ,
-			   unsigned int x1 ,unsigned int y1 , unsigned int radius)
-{
-  int f = 1 - (int)radius;
-  int ddF_x = 1;
-  int ddF_y = -2 * (int)radius;
-  int step_x = 0;
-  int step_y = (int)radius;
-  
-  unsigned int x = x0 + radius;
-  unsigned int y = y0 + radius;
-  unsigned int offset_x = x1 - x0 - (radius << 1);
-  unsigned int offset_y = y1 - y0 - (radius << 1);
-
-  while(step_x < step_y)
-    {
-      if(f >= 0) 
-	{
-	  step_y--;
-	  ddF_y += 2;
-	  f += ddF_y;
-	}
-      step_x++;
-      ddF_x += 2;
-      f += ddF_x;    
-
-      _DrawLine_H( x - step_x, y - step_y, x + step_x + offset_x, y - step_y);
-      _DrawLine_H( x - step_y, y - step_x, x + step_y + offset_x, y - step_x);
-      _DrawLine_H( x - step_x, y + step_y + offset_y,
-		   x + step_x + offset_x, y + step_y + offset_y);
-      _DrawLine_H( x - step_y, y + step_x + offset_y,
-		   x + step_y + offset_x, y + step_x + offset_y);
-    }
-
-  while(y0 + radius <= y1 - radius )
-    {
-      _DrawLine_H( x0, y0 + radius, x1, y0 + radius);
-      y0++;
-    }
-}
-
-/**
-********************************************************************************
-* @function  void FillRoundRect(unsigned char **args ,int arg_num)
-* @brief     Get parameters and call the _FillRoundRect function.
-********************************************************************************
-**/
-static void FillRoundRect(unsigned char **args ,int arg_num)
-{
-  unsigned int location[5] ,count ,tmp;
-  unsigned int delta_x,delta_y;
-  
-  if(arg_num != 5 && arg_num != 4)
-    {
-      return;      
-    }
-
-  for(count = 0 ;count < (unsigned int)arg_num; count++)
-    {
-      location[count] = str_to_uint(*(args + count));
-    }
-
-  /*location out of range*/
-  if(location[0] > display_x || location[2] > display_x || 
-     location[1] > display_y || location[3] > display_y)
-    {
-      return ;
-    }
-
-  if(location[0] > location[2])
-    {
-      tmp = location[0];
-      location[0] = location[2];
-      location[2] = tmp;
-    }
-
-  if(location[1] > location[3])
-    {
-      tmp = location[1];
-      location[1] = location[3];
-      location[3] = tmp;
-    }
-  
-  delta_x = location[2] - location[0];
-  delta_y = location[3] - location[1];
-
-  if(arg_num == 4)
-    {
-      location[4] = (delta_x < delta_y)?(delta_x >> 2):(delta_y >> 2);
-    }
-  else if((location[4] << 1) > delta_x || (location[4] << 1) > delta_y)
-    {
-      return;
-    }
-
-  _FillRoundRect(location[0],location[1],location[2],location[3],location[4]);
-}
-
-/**
-********************************************************************************
-* @function  _print_char(unsigned int x ,unsigned int y ,unsigned char c)
-* @brief     print a character on LCD.
-********************************************************************************
-**/
-static void _print_char(unsigned int x ,unsigned int y ,unsigned char c)
-{
-  unsigned char i,ch;
-  unsigned int j;
-  unsigned int array_count;
-
-  SetXY(x, y, x + cfont.x_size - 1, y + cfont.y_size - 1);
-  array_count=((c - cfont.offset )*((cfont.x_size/8)*cfont.y_size))+4;
-  for(j=0;j<((cfont.x_size/8)*cfont.y_size);j++)
-    {
-      ch=*(cfont.font + array_count);
-      for(i=0;i<8;i++)
-	{   
-	  if((ch&(1<<(7-i)))!=0)   
-	    {
-	      Write_Data(front_color);
-	    } 
-	  else
-	    {
-	      Write_Data(back_color);
-	    }   
-	}
-      array_count++;
-    }
-}
-
-
-/**
-********************************************************************************
-* @function  void PrintString(unsigned char **args, int arg_num)
-* @brief     print a string on LCD.
-********************************************************************************
-**/
-static void PrintString(unsigned char **args, int arg_num)
-{
-  unsigned int location[2] ,count;
-  unsigned char *str;
-  if(arg_num != 3)
-    {
-      return;      
-    }
-
-  for(count = 0 ;count < 2; count++)
-    {
-      location[count] = str_to_uint(*(args + count));
-    }
-
-  if(location[0] >= display_x - cfont.x_size || 
-     location[1] >= display_y - cfont.y_size)
-    {
-      return;
-    }
-
-  str = *(args + 2);
-
-  while(*str != '\0')
-    {
-      _print_char(location[0] ,location[1] , *str);
-      location[0] += cfont.x_size;
-
-      if(location[0] >= display_x - cfont.x_size)
-	{
-	  location[0] = 0;
-	  location[1] += cfont.y_size;
-	}
-      if(location[1] >= display_y - cfont.y_size) 
-	{
-	  return ;
-	}
-
-      str++;
-    }
-}
-
-
-/**
-********************************************************************************
-* @function  void SetFont(unsigned char **args, int arg_num)
-* @brief     Choose a font. font in file "DefaultFonts.h"
-********************************************************************************
-**/
-static void SetFont(unsigned char **args, int arg_num)
-{
-  unsigned char font_index;
-
-  if(arg_num != 1)
-    {
-      return;
-    }
-
-  font_index = **args;
-
-  switch(font_index)
-    {
-    case '3':
-      cfont.font = SevenSegNumFont;
-      break;
-    case '2':
-      cfont.font = BigFont;
-      break;
-    case '1':
-    default:
-      cfont.font = SmallFont;
-      break;
-    }
-
-  cfont.x_size = *cfont.font;
-  cfont.y_size = *(cfont.font + 1);
-  cfont.offset = *(cfont.font + 2);
-  cfont.numchars = *(cfont.font + 3);
-}
-
-/**
-********************************************************************************
-* @function  void GetFont_uart1(unsigned char **args, int arg_num)
-* @brief     print the current font name to usart1
-********************************************************************************
-**/
-static void GetFont_uart1(unsigned char **args, int arg_num)
-{
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++;
-      return ;
-    }
-
-  if(cfont.font == SmallFont)
-    {
-      usart1.printf(&usart1,"The current font name is 'SmallFont'\n");
-    }
-  else if(cfont.font == BigFont)
-    {
-      usart1.printf(&usart1,"The current font name is 'BigFont'\n");
-    }
-  else if(cfont.font == SevenSegNumFont)
-    {
-      usart1.printf(&usart1,"The current font name is 'SevenSegNumFont'\n");
-    }
-  else
-    {
-      usart1.printf(&usart1,"The current font is unknown.\n");
-    }
-
-  usart1.printf(&usart1,"Font X_size is %d\n",cfont.x_size);
-  usart1.printf(&usart1,"Font Y_size is %d\n",cfont.y_size);
-  usart1.printf(&usart1,"Font characters num is %d\n",cfont.numchars);
-}
-
-/**
-********************************************************************************
-* @function  void GetFontXSize_uart1(unsigned char **args ,int arg_num)
-* @brief     print current font xsize to usart1.
-********************************************************************************
-**/
-static void GetFontXSize_uart1(unsigned char **args ,int arg_num)
-{
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++;
-      return ;
-    }
-  usart1.printf(&usart1,"Current font X_size is %d\n",cfont.x_size);
-}
-
-/**
-********************************************************************************
-* @function  void GetFontYSize_uart1(unsigned char **args ,int arg_num)
-* @brief     print current font xsize to usart1.
-********************************************************************************
-**/
-static void GetFontYSize_uart1(unsigned char **args ,int arg_num)
-{
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++;
-      return ;
-    }
-  usart1.printf(&usart1,"Current font Y_size is %d\n",cfont.y_size);
-}
-
-
-/**
-********************************************************************************
-* @function  void GetDisplayXSize_uart1(unsigned char **args ,int arg_num)
-* @brief     print current LCD diplay area xsize to usart1.
-********************************************************************************
-**/
-static void GetDisplayXSize_uart1(unsigned char **args ,int arg_num)
-{
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++;
-      return ;
-    }
-  usart1.printf(&usart1,"Current LCD x_size is %d\n",display_x);
-}
-
-/**
-********************************************************************************
-* @function  void GetDisplayYSize_uart1(unsigned char **args ,int arg_num)
-* @brief     print current LCD diplay area ysize to usart1.
-********************************************************************************
-**/
-static void GetDisplayYSize_uart1(unsigned char **args ,int arg_num)
-{
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++;
-      return ;
-    }
-  usart1.printf(&usart1,"Current LCD y_size is %d\n",display_y);
-}
-
-/**
-********************************************************************************
-* @function  void DeviceOn(unsigned char **args ,int arg_num)
-* @brief     turn on the back light .
-********************************************************************************
-**/
-static void DeviceOn(unsigned char **args ,int arg_num)
-{
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++;
-      return ;
-    }
- if(usart1.debug == 1)
-   {
-     usart1.printf(&usart1,"Device on\n");
-   }
-  GPIO_SetBits(GPIOD, GPIO_Pin_3);
-}
-
-
-/**
-********************************************************************************
-* @function  void DeviceOff(unsigned char **args ,int arg_num)
-* @brief     turn off the back light.
-********************************************************************************
-**/
-static void DeviceOff(unsigned char **args ,int arg_num)
-{
-  if(arg_num != 0)
-    {
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-      unsigned char *p = *args;
-      p++ ;
-      return ;
-    }
- if(usart1.debug == 1)
-   {
-     usart1.printf(&usart1,"Device off\n");
-   }
-  GPIO_ResetBits(GPIOD, GPIO_Pin_3);
-}
-
-/**
-********************************************************************************
-* @function  void idle_hx8347a(unsigned char **args ,int arg_num)
-* @brief     Do nothing.
-*            Some object_lcd interface functions which HX8347A does not support,
-*            link to this function. (avoid idle function pointer)
-********************************************************************************
-**/
-static void idle_hx8347a(unsigned char **args ,int arg_num)
-{
-  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
-  unsigned char *p = *args;
-  int tmp = arg_num;
-  p++ ;
-  tmp++;
- if(usart1.debug == 1)
-   {
-     usart1.printf(&usart1,"HX8347A does not support this function\n");
-   }
-}
-
-#if 0
-void DrewBitmap(void)
-{
-  ;
-}
-#endif
-
-
-/**
-********************************************************************************
-* @function  int get_lcd_index(object_ATcmd *at_cmd)
-* @brief     Get the lcd index in the array lcd_index
-* @return    count  --> the lcd index in lcd_index
-*            -1 --> fail
-********************************************************************************
-**/
-static int get_lcd_index(char *lcd_name)
-{
-  int count;
-  for(count = 0; count < MAX_LCD_INDEX_NUM ;count++)
-    {
-      /*check the first 7 chararcters*/
-      if( strncmp((const char*)lcd_name ,
-		  (const char*)&lcd_index[count] , 7) == 0)
-	{
-    	  return count;
-	}
-    }
-  return -1;
-}
-
-  /**
-********************************************************************************
-* @function  void set_device(unsigned char **args ,int arg_num)
-* @brief     Reset the LCD index in lcd_index[] 
-*            This need a global object_lcd variable 'global_lcd' .
-*            And it will reinitialize the LCD.
-********************************************************************************
-**/
-
-static void SetDevice(unsigned char **args ,int arg_num)
-{
-  unsigned char * lcd_name;
-  int index;
-  if(arg_num != 1)
-    {
-      return ;
-    }
-
-  lcd_name = *args;
-
-  index = get_lcd_index((char *)lcd_name);
-
-  if(index == -1)
-    {
-      if(usart1.debug == 1)
-	{
-	  usart1.printf(&usart1,"The '%s' is not support\n",lcd_name);
-	}
-      return ;
-    }
-  if(usart1.debug == 1)
-    {
-      usart1.printf(&usart1,"Set lcd_index to '%s'\n",lcd_name);
-    }
-  global_lcd.index = index;
-  object_lcd_init(&global_lcd);
-}
-
-/**
-********************************************************************************
-*  @function    int action_test(unsigned char **args, int arg_num)
-*  @brief       print the parameters in one command.
-*               Just for test.
-********************************************************************************
-**/
-static void action_test(unsigned char **args, int arg_num)
-{
-  int count;
-  if(usart1.debug == 1)
-    {
-      usart1.printf(&usart1,"This is object_lcd test action.\n");
-      if(arg_num == 0)
-	{
-	  usart1.printf(&usart1,"No parameter. \n");
-	}
-      for(count = 0; count < arg_num; count++)  
-	{
-	  usart1.printf(&usart1,"param %d = %s\n",count+1,*(args+count));
-	}
-    }
-}
-
-
-/**
-********************************************************************************
-*  @function    int object_lcd_init(object_lcd * lcd);
-*  @brief       Set up lcd object interface.
-*               Here , all the actions are link to their real functions.
-*  @return      return 0  --> succeed
-*               return -1 --> fail
-********************************************************************************
-**/
-int object_lcd_init(object_lcd * lcd)
-{
-  FSMC_Init();
-
-  switch(lcd->index)
-    {
-    case 0: /* HX8347A */
-    default:
-      display_x = lcd_index[0].x_size;
-      display_y = lcd_index[0].y_size;
-
-      lcd->lcd_init = LCD_Init_hx8347a;
-
-      lcd->set_contrast = idle_hx8347a;
-      lcd->set_brightness = idle_hx8347a;
-      lcd->set_display_page = idle_hx8347a;
-      lcd->write_page = idle_hx8347a;
-      break;
-    }
-
-  lcd->set_device = SetDevice;
-
-  lcd->get_lcd_Xsize = GetDisplayXSize_uart1;
-  lcd->get_lcd_Ysize = GetDisplayYSize_uart1;
-  lcd->device_on = DeviceOn;
-  lcd->device_off = DeviceOff;
-
-  lcd->clear_screen = ClearScreen;
-  lcd->fill_screen = FillScreen;
-  lcd->set_front_color = SetFrontColor;
-  lcd->get_front_color = GetFrontColor_uart1;
-  lcd->set_back_color = SetBackColor;
-  lcd->get_back_color = GetBackColor_uart1;
-  lcd->draw_point = DrawPoint;
-  lcd->draw_line = DrawLine;
-  lcd->draw_rectangle = DrawRectangle;
-  lcd->draw_cricle = DrawCircle;
-  lcd->d_round_rectangle = DrawRoundRect;
-  lcd->fill_rectangle = FillRectangle;
-  lcd->fill_cricle = FillCircle;
-  lcd->f_round_rectangle = FillRoundRect;
-  lcd->print_string = PrintString;
-  lcd->print_integer = PrintString;
-  lcd->print_float = PrintString;
-  lcd->set_font = SetFont;
-  lcd->get_font = GetFont_uart1;
-  lcd->get_font_Xsize = GetFontXSize_uart1; 
-  lcd->get_font_Ysize = GetFontYSize_uart1;
-  lcd->draw_bitmap = action_test;
-
-  lcd->lcd_init((unsigned char **)0,0);
-  lcd->clear_screen((unsigned char **)0,0);
-  return 0;
-}
+/**
+********************************************************************************
+* @file     lcd_object.c
+* @author   
+* @version  v0.1
+* @date     2014.11.27
+* @brief    This file contains all functions that support object_lcd interface
+*           Note: some functions need initialized global 'usart1'
+********************************************************************************
+**/
+
+#include <string.h>      /* strncmp() ,strlen() ,memcpy() ... */
+#include <stm32f10x.h>   /* gpio functions */
+#include "delay.h"       /* Delayms(__IO uint32_t nTime) ,GetTickms() */
+#include "FSMCDriver.h"  /* FSMC_Init() */
+#include "uart_object.h" /* object_uart interface & global 'usart1' */
+#include "lcd_object.h"  /* object_lcd interface */
+#include "DefaultFonts.h"
+
+
+/**
+********************************************************************************
+* @array    lcd_index[]
+* @brief    LCD type index.
+*           LCD in this array can be used.
+********************************************************************************
+**/
+
+struct _lcd_type 
+{
+  const char name[8];
+  unsigned int x_size;
+  unsigned int y_size;
+};
+
+#define MAX_LCD_INDEX_NUM 1
+
+static const struct _lcd_type lcd_index[] =
+  {
+    { "HX8347A", 240 , 320}    /* HX8347A , Xsize = 240 ,Ysize = 320*/
+  };
+
+
+/**
+********************************************************************************
+* @variable front_color , back_color
+*           display_x , display_y
+*           cfont
+* @brief    Global LCD information variables in this file. (Only in this file)
+*           front_color  --> color for drawn area, 0~65535 
+*           back_color   --> color for blank area, 0~65525
+*           display_x    --> the max x_size of the current LCD
+*           display_y    --> the max y_size of the current LCD
+*           cfont        --> the current font to be used
+********************************************************************************
+**/
+
+static unsigned int front_color = 0,back_color = 65535;
+static unsigned int display_x = 0;
+static unsigned int display_y = 0;
+
+struct _current_font
+{
+  const unsigned char *font; /* font name in file 'DefaultFonts.h' */
+  unsigned int x_size;       /* font Xsize */
+  unsigned int y_size;       /* font Ysize */
+  unsigned int offset;       /* used to calculate the location of a character */
+  unsigned int numchars;     /* characters' number in current font array */
+};
+
+static struct _current_font cfont = {SmallFont , 0x08, 0x0c, 0x20, 0x5f};  
+
+/**
+********************************************************************************
+* @variable screen_epoch
+* @brief    Counted up each time the whole screen is filled (FillScreen ,
+*           ClearScreen). Anything remembering what is on the screen (text
+*           slots) compares it to know the screen was wiped.
+********************************************************************************
+**/
+static unsigned int screen_epoch = 0;
+
+
+/**
+********************************************************************************
+* @micro    Bank1_LCD_D 
+*           Bank1_LCD_C 
+* @brief    Hardware related :
+*           GPIO PD2 --> LCD_RST
+*           GPIO PD3 --> LCD_ON
+*           STM32F103F use "FSMC" to communicate with LCD controller.
+*           In this way ,the LCD Data_addr is link to memory_addr 0x60020000
+*           the LCD Reg_addr is link to memory_addr 0x60000000
+********************************************************************************
+**/
+#define Bank1_LCD_D    ((uint32_t)0x60020000)    //disp Data ADDR
+#define Bank1_LCD_C    ((uint32_t)0x60000000)    //disp Reg ADDR
+
+/**
+********************************************************************************
+* @micro    LCD_DATA_APERTURE_SIZE
+* @brief    The LCD RS pin is FSMC A16. On a 16 bit bus A16 is address bit 17,
+*           so every address from Bank1_LCD_D to Bank1_LCD_D + 0x1FFFF
+*           (0x60020000 ~ 0x6003FFFF) writes the LCD data port.
+*           32 bit stores ,multi word stores and incrementing DMA can use
+*           this range ,the FSMC splits them into 16 bit data writes.
+********************************************************************************
+**/
+#define LCD_DATA_APERTURE_SIZE ((uint32_t)0x00020000)
+
+
+/**
+********************************************************************************
+* @micro    LCD_DMA_CHANNEL
+*           LCD_DMA_IRQ
+*           LCD_DMA_MAX_COUNT
+*           LCD_DMA_MIN_PIXELS
+* @brief    DMA2 channel 1 writes the GRAM in memory-to-memory mode.
+*           Fill : the source is the half-word 'dma_fill_color' and the
+*                  destination is Bank1_LCD_D ,neither address is incremented.
+*           Copy : both the source buffer and the data aperture addresses
+*                  are incremented.
+*           One DMA transfer is at most 65535 half-words (it always fits in
+*           the data aperture) ,longer ones are chained in the transfer
+*           complete interrupt.
+*           Transfers shorter than LCD_DMA_MIN_PIXELS are done by the CPU ,
+*           setting up the DMA would take longer than the transfer itself.
+********************************************************************************
+**/
+#define LCD_DMA_CHANNEL     DMA2_Channel1
+#define LCD_DMA_IRQ         DMA2_Channel1_IRQn
+#define LCD_DMA_MAX_COUNT   65535
+#define LCD_DMA_MIN_PIXELS  64
+
+/**
+********************************************************************************
+* @variable dma_fill_color , dma_src , dma_src_inc ,
+*           dma_fill_remain , dma_fill_busy
+* @brief    DMA state ,shared with DMA2_Channel1_IRQHandler().
+*           dma_fill_color  --> the half-word copied to the GRAM by a fill
+*           dma_src         --> source address of the next part
+*           dma_src_inc     --> 0 = fill , 1 = copy (incrementing addresses)
+*           dma_fill_remain --> pixels not handed to the DMA yet
+*           dma_fill_busy   --> 1 = a transfer is running ,the bus is not free
+********************************************************************************
+**/
+static volatile uint16_t dma_fill_color = 0;
+static volatile uint32_t dma_src = 0;
+static volatile unsigned char dma_src_inc = 0;
+static volatile uint32_t dma_fill_remain = 0;
+static volatile unsigned char dma_fill_busy = 0;
+
+/**
+********************************************************************************
+* @function  void LCD_DMA_Wait(void)
+* @brief     Wait until the running DMA fill (if any) is finished.
+*            Everything that talks to the LCD must call this first.
+********************************************************************************
+**/
+static void LCD_DMA_Wait(void)
+{
+  while(dma_fill_busy != 0);
+}
+
+/**
+********************************************************************************
+* @function  void LCD_DMA_Next(void)
+* @brief     Hand the next (at most LCD_DMA_MAX_COUNT) pixels to the DMA.
+*            The channel must be disabled before calling this function.
+********************************************************************************
+**/
+static void LCD_DMA_Next(void)
+{
+  uint32_t count;
+
+  count = (dma_fill_remain > LCD_DMA_MAX_COUNT)?
+    LCD_DMA_MAX_COUNT : dma_fill_remain;
+  dma_fill_remain -= count;
+
+  LCD_DMA_CHANNEL->CPAR = dma_src;
+  LCD_DMA_CHANNEL->CMAR = Bank1_LCD_D;
+  if(dma_src_inc != 0)
+    {
+      LCD_DMA_CHANNEL->CCR |= DMA_CCR1_PINC | DMA_CCR1_MINC;
+      dma_src += count << 1;  /* the next part starts after this one */
+    }
+  else
+    {
+      LCD_DMA_CHANNEL->CCR &= ~(DMA_CCR1_PINC | DMA_CCR1_MINC);
+    }
+
+  DMA_SetCurrDataCounter(LCD_DMA_CHANNEL, (uint16_t)count);
+  DMA_Cmd(LCD_DMA_CHANNEL, ENABLE);
+}
+
+/**
+********************************************************************************
+* @function  void LCD_DMA_Fill(unsigned int color ,uint32_t count)
+* @brief     Write 'count' pixels of 'color' to the GRAM by DMA.
+*            The GRAM window must have been set (SetXY).
+*            This function returns at once ,the fill goes on in background.
+********************************************************************************
+**/
+static void LCD_DMA_Fill(unsigned int color ,uint32_t count)
+{
+  if(count == 0)
+    {
+      return;
+    }
+
+  LCD_DMA_Wait();
+
+  dma_fill_color = (uint16_t)color;
+  dma_src = (uint32_t)&dma_fill_color;
+  dma_src_inc = 0;
+  dma_fill_remain = count;
+  dma_fill_busy = 1;
+  LCD_DMA_Next();
+}
+
+/**
+********************************************************************************
+* @function  void LCD_DMA_Copy(const uint16_t *buf ,uint32_t count)
+* @brief     Copy 'count' pixels from 'buf' to the GRAM by DMA.
+*            The GRAM window must have been set (SetXY).
+*            This function returns at once ,'buf' must not change until
+*            the copy is finished (LCD_DMA_Wait).
+********************************************************************************
+**/
+static void LCD_DMA_Copy(const uint16_t *buf ,uint32_t count)
+{
+  if(count == 0)
+    {
+      return;
+    }
+
+  LCD_DMA_Wait();
+
+  dma_src = (uint32_t)buf;
+  dma_src_inc = 1;
+  dma_fill_remain = count;
+  dma_fill_busy = 1;
+  LCD_DMA_Next();
+}
+
+/**
+********************************************************************************
+* @function  void LCD_DMA_Init(void)
+* @brief     Set up DMA2 channel 1 for GRAM fills and enable its interrupt.
+********************************************************************************
+**/
+static void LCD_DMA_Init(void)
+{
+  DMA_InitTypeDef DMA_InitStructure;
+  NVIC_InitTypeDef NVIC_InitStructure;
+
+  LCD_DMA_Wait();
+
+  RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA2, ENABLE);
+
+  DMA_DeInit(LCD_DMA_CHANNEL);
+  DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&dma_fill_color;
+  DMA_InitStructure.DMA_MemoryBaseAddr = Bank1_LCD_D;
+  DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+  DMA_InitStructure.DMA_BufferSize = 1;
+  DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+  DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Disable;
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+  DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+  DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+  DMA_InitStructure.DMA_Priority = DMA_Priority_Low;
+  DMA_InitStructure.DMA_M2M = DMA_M2M_Enable;
+  DMA_Init(LCD_DMA_CHANNEL, &DMA_InitStructure);
+
+  DMA_ITConfig(LCD_DMA_CHANNEL, DMA_IT_TC | DMA_IT_TE, ENABLE);
+
+  NVIC_InitStructure.NVIC_IRQChannel = LCD_DMA_IRQ;
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+  NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+********************************************************************************
+* @function  void DMA2_Channel1_IRQHandler(void)
+* @brief     DMA2 channel 1 ISR
+*            chain the next part of a long fill ,or mark the fill finished.
+********************************************************************************
+**/
+void DMA2_Channel1_IRQHandler(void);    /* vector table ,not called here */
+
+void DMA2_Channel1_IRQHandler(void)
+{
+  if(DMA_GetITStatus(DMA2_IT_TE1) == SET)  /* transfer error ,give up */
+    {
+      DMA_ClearITPendingBit(DMA2_IT_GL1);
+      DMA_Cmd(LCD_DMA_CHANNEL, DISABLE);
+      dma_fill_remain = 0;
+      dma_fill_busy = 0;
+      return;
+    }
+
+  if(DMA_GetITStatus(DMA2_IT_TC1) == SET)  /* transfer complete */
+    {
+      DMA_ClearITPendingBit(DMA2_IT_GL1);
+      DMA_Cmd(LCD_DMA_CHANNEL, DISABLE);
+      if(dma_fill_remain != 0)
+	{
+	  LCD_DMA_Next();
+	}
+      else
+	{
+	  dma_fill_busy = 0;
+	}
+    }
+}
+
+
+/**
+********************************************************************************
+* @function  unsigned int RGB_to_color(int r ,int g ,int b)
+* @brief     translate (RGB) data to (unsigned int) data.
+*            RGB 16bit: R(5)G(6)B(5)
+********************************************************************************
+**/
+static unsigned int RGB_to_color(unsigned int r ,unsigned int g ,unsigned int b)
+{
+  unsigned int color;  
+  color =  (r & 248) <<8 | (g & 252) <<3 | (b & 248) >>3;
+  return color;
+}
+
+
+/**
+********************************************************************************
+* @variable bus_hook
+* @brief    Called by the window functions (SetWindow ,SetSpan ,SetRun_V ,
+*           SetEntry ,SetScroll) before they look at the shadow registers ,
+*           every drawing starts with one of them. Drawings kept back in RAM
+*           (the culling queue ,the frame display list) use it to get out to
+*           the GRAM before anything else is drawn ,so the drawing order is
+*           kept.
+*           It is not called by Write_Command() ,the hook's own drawing
+*           would move the window under a caller that has already checked
+*           the shadow.
+*           The hook must check for itself that it is not called again by
+*           its own drawing.
+********************************************************************************
+**/
+static void (*bus_hook)(void) = 0;
+
+/**
+********************************************************************************
+* @function  void BusHook(void)
+* @brief     Call bus_hook if it is set.
+********************************************************************************
+**/
+static void BusHook(void)
+{
+  if(bus_hook != 0)
+    {
+      bus_hook();
+    }
+}
+
+/**
+********************************************************************************
+* @function  void Write_Command(unsigned int index)
+* @brief     Send a value to LCD Reg_Address
+********************************************************************************
+**/
+static void Write_Command(unsigned int index)
+{
+    LCD_DMA_Wait();
+    *(__IO uint16_t *) (Bank1_LCD_C)= index;
+}
+
+/**
+********************************************************************************
+* @function  void Write_Command_Data(unsigned int index,unsigned int val)
+* @brief     Send a value to LCD Reg_Address and follow a data to Data_Address
+********************************************************************************
+**/
+static void Write_Command_Data(unsigned int index,unsigned int val)
+{
+  LCD_DMA_Wait();
+  *(__IO uint16_t *) (Bank1_LCD_C)= index;
+  *(__IO uint16_t *) (Bank1_LCD_D)= val;
+
+}
+
+/**
+********************************************************************************
+* @function  void  Write_Data(unsigned int val)
+* @brief     Send a value to LCD Data_Address
+********************************************************************************
+**/
+static void  Write_Data(unsigned int val)
+{   
+  *(__IO uint16_t *) (Bank1_LCD_D)= val;
+
+}
+
+/**
+********************************************************************************
+* @function  void lcd_fill_pixels(unsigned int color ,uint32_t n)
+* @brief     Write 'n' pixels of 'color' to the GRAM data port.
+*            Two pixels go out with one 32 bit store to the data aperture ,
+*            long fills are handed to the DMA.
+*            The GRAM window must have been set (SetXY).
+********************************************************************************
+**/
+static void lcd_fill_pixels(unsigned int color ,uint32_t n)
+{
+  __IO uint32_t *port = (__IO uint32_t *)Bank1_LCD_D;
+  uint32_t pair;
+
+  if(n >= LCD_DMA_MIN_PIXELS)
+    {
+      LCD_DMA_Fill(color, n);
+      return;
+    }
+
+  LCD_DMA_Wait();
+
+  pair = (color & 0xffff) | ((color & 0xffff) << 16);
+  while(n >= 8)
+    {
+      port[0] = pair;
+      port[1] = pair;
+      port[2] = pair;
+      port[3] = pair;
+      n -= 8;
+    }
+  while(n >= 2)
+    {
+      port[0] = pair;
+      n -= 2;
+    }
+  if(n != 0)
+    {
+      Write_Data(color);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void lcd_write_pixels(const uint16_t *buf ,uint32_t n)
+* @brief     Write 'n' pixels from 'buf' to the GRAM data port.
+*            The pixels are copied by 32 bit stores to the data aperture ,
+*            long buffers are copied by incrementing DMA.
+*            A buffer in RAM may be reused when this function returns ,
+*            a buffer in flash is left to the DMA.
+*            The GRAM window must have been set (SetXY).
+********************************************************************************
+**/
+static void lcd_write_pixels(const uint16_t *buf ,uint32_t n)
+{
+  __IO uint32_t *port = (__IO uint32_t *)Bank1_LCD_D;
+  const uint32_t *src;
+
+  if(n >= LCD_DMA_MIN_PIXELS)
+    {
+      LCD_DMA_Copy(buf, n);
+      if((uint32_t)buf >= SRAM_BASE) /* RAM buffer ,wait for the DMA */
+	{
+	  LCD_DMA_Wait();
+	}
+      return;
+    }
+
+  LCD_DMA_Wait();
+
+  if(((uint32_t)buf & 0x02) != 0 && n != 0) /* word align the source */
+    {
+      Write_Data(*buf++);
+      n--;
+    }
+
+  src = (const uint32_t *)buf;
+  while(n >= 8)
+    {
+      port[0] = src[0];
+      port[1] = src[1];
+      port[2] = src[2];
+      port[3] = src[3];
+      src += 4;
+      n -= 8;
+    }
+  while(n >= 2)
+    {
+      port[0] = *src++;
+      n -= 2;
+    }
+  if(n != 0)
+    {
+      Write_Data(*(const uint16_t *)src);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void lcd_read_pixels(uint16_t *buf ,uint32_t n)
+* @brief     Read 'n' pixels (RGB565) from the GRAM data port to 'buf'.
+*            The first read after the GRAM command is a dummy read ,the
+*            address counter then moves on with every pixel like a write.
+*            The reads use the slower FSMC read timing (FSMC_Init).
+*            The GRAM window must have been set by SetXY(). SetXY() runs
+*            bus_hook before it writes the window ,so the drawings kept back
+*            are already in the GRAM and the window is the caller's.
+********************************************************************************
+**/
+static void lcd_read_pixels(uint16_t *buf ,uint32_t n)
+{
+  __IO uint16_t *port = (__IO uint16_t *)Bank1_LCD_D;
+
+  LCD_DMA_Wait();
+
+  (void)*port;    /* dummy read */
+  while(n != 0)
+    {
+      *buf++ = *port;
+      n--;
+    }
+}
+
+/**
+********************************************************************************
+* @variable line_buf
+* @brief    One scanline of pixels ,2 pixels a word.
+*           Shared by the row renderers ,the data is always sent before they
+*           return.
+********************************************************************************
+**/
+#define LCD_LINE_WORDS 120    /* 240 pixels */
+
+static uint32_t line_buf[LCD_LINE_WORDS];
+
+/**
+********************************************************************************
+* @function  unsigned int str_to_uint(unsigned char *str)
+* @brief     Change a string to integer. Like " int atoi(const char*) "
+*            For example :
+*             str=" 1 2 3" --> (int)num=str_to_uint(str) --> num = 123
+*            Note: only string like "0123 456789" can be transformed.[123456789]
+* @return    num --> transformed integer 
+********************************************************************************
+**/
+
+static unsigned int str_to_uint(unsigned char *str)
+{
+  unsigned int num;
+
+  unsigned char *p;
+  p = str;
+  num = 0;
+  while(*p != '\0')
+  {
+	  if( *p > '/' && *p < ':') /* *p = '0' ~ '9' */
+	  {
+		  num = (num << 3) + (num << 1) + *p - '0'; /* num = num * 10 + next_bit*/
+	  }
+
+    p++;
+  }
+  return num;
+}
+
+/**
+********************************************************************************
+* @function  int str_to_int(unsigned char *str)
+* @brief     Change a string to a signed integer ,like str_to_uint() but a
+*            leading '-' makes it negative.
+*            For example : str="-12" --> num = -12
+* @return    num --> transformed integer
+********************************************************************************
+**/
+static int str_to_int(unsigned char *str)
+{
+  unsigned char *p = str;
+
+  while(*p == ' ')
+    {
+      p++;
+    }
+  if(*p == '-')
+    {
+      return -(int)str_to_uint(p + 1);
+    }
+  return (int)str_to_uint(p);
+}
+
+
+/**
+********************************************************************************
+* @struct   _lcd_shadow
+* @variable shadow , reg_written , reg_skipped
+* @brief    A copy of the window registers last written to the controller.
+*           A window register is only written when its value changes.
+*           h_ram   --> R44h : (x1 << 8) + x0
+*           v_start --> R45h : y0
+*           v_end   --> R46h : y1
+*           entry   --> R11h : entry mode ,LCD_ENTRY_H or LCD_ENTRY_V
+*           valid   --> 0 = the registers are unknown (after LCD_Init)
+*           scroll  --> R41h : vertical scroll ,the GRAM line shown at the
+*                       top of the screen
+*           reg_written --> register writes sent by SetWindow/SetCursor
+*           reg_skipped --> register writes saved by the shadow
+********************************************************************************
+**/
+struct _lcd_shadow
+{
+  unsigned int h_ram;
+  unsigned int v_start;
+  unsigned int v_end;
+  unsigned int entry;
+  unsigned char valid;
+  unsigned int scroll;
+};
+
+/**
+********************************************************************************
+* @micro    LCD_ENTRY_H , LCD_ENTRY_V
+* @brief    R11h entry mode values.
+*           LCD_ENTRY_H --> address counter moves along the row (AM = 0)
+*                           this is the mode set by LCD_Init ,all the other
+*                           functions expect it.
+*           LCD_ENTRY_V --> address counter moves down the column (AM = 1)
+*                           used for vertical runs ,set it back when done.
+********************************************************************************
+**/
+#define LCD_ENTRY_H  0x6070
+#define LCD_ENTRY_V  0x6078
+
+static struct _lcd_shadow shadow = {0, 0, 0, LCD_ENTRY_H, 0, 0};
+static unsigned long reg_written = 0;
+static unsigned long reg_skipped = 0;
+
+/**
+********************************************************************************
+* @function  void SetWindow(unsigned int x0,unsigned int y0,
+*                           unsigned int x1,unsigned int y1)
+* @brief     Set the GRAM window ,only the changed registers are written.
+*            The address counter is not moved ,call SetCursor() after this.
+********************************************************************************
+**/
+static void SetWindow(unsigned int x0,unsigned int y0,
+		      unsigned int x1,unsigned int y1)
+{
+  unsigned int h_ram = (x1 << 8) + x0;
+
+  BusHook();
+
+  if(shadow.valid == 0 || shadow.h_ram != h_ram)
+    {
+      Write_Command_Data(0x0044,h_ram);
+      shadow.h_ram = h_ram;
+      reg_written++;
+    }
+  else
+    {
+      reg_skipped++;
+    }
+
+  if(shadow.valid == 0 || shadow.v_start != y0)
+    {
+      Write_Command_Data(0x0045,y0);
+      shadow.v_start = y0;
+      reg_written++;
+    }
+  else
+    {
+      reg_skipped++;
+    }
+
+  if(shadow.valid == 0 || shadow.v_end != y1)
+    {
+      Write_Command_Data(0x0046,y1);
+      shadow.v_end = y1;
+      reg_written++;
+    }
+  else
+    {
+      reg_skipped++;
+    }
+
+  shadow.valid = 1;
+}
+
+/**
+********************************************************************************
+* @function  void SetEntry(unsigned int mode)
+* @brief     Set the entry mode (LCD_ENTRY_H or LCD_ENTRY_V) if it changes.
+********************************************************************************
+**/
+static void SetEntry(unsigned int mode)
+{
+  BusHook();
+
+  if(shadow.entry != mode)
+    {
+      Write_Command_Data(0x0011,mode);
+      shadow.entry = mode;
+      reg_written++;
+    }
+  else
+    {
+      reg_skipped++;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void SetScroll(unsigned int line)
+* @brief     Set the vertical scroll (R41h) ,GRAM line 'line' is shown at
+*            the top of the screen and the GRAM wraps around below it.
+*            Note: line < display_y
+********************************************************************************
+**/
+static void SetScroll(unsigned int line)
+{
+  BusHook();
+
+  if(shadow.scroll != line)
+    {
+      Write_Command_Data(0x0041,line);
+      shadow.scroll = line;
+      reg_written++;
+    }
+  else
+    {
+      reg_skipped++;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void SetCursor(unsigned int x,unsigned int y)
+* @brief     Move the GRAM address counter and start a GRAM write.
+*            (x,y) must be in the current window.
+*            bus_hook is not called here ,use SetXY ,SetSpan or SetRun_V.
+********************************************************************************
+**/
+static void SetCursor(unsigned int x,unsigned int y)
+{
+  Write_Command_Data(0x004e,x);
+  Write_Command_Data(0x004f,y);
+  Write_Command (0x0022);//LCD_WriteCMD(GRAMWR);
+  reg_written += 3;
+}
+
+/**
+********************************************************************************
+* @function  int InWindow(unsigned int x0,unsigned int x1,unsigned int y)
+* @brief     Check if the pixels x0 ~ x1 of row y are in the current window.
+* @return    1 --> yes , the cursor can be moved there directly
+*            0 --> no
+********************************************************************************
+**/
+static int InWindow(unsigned int x0,unsigned int x1,unsigned int y)
+{
+  return (shadow.valid != 0 &&
+	  x0 >= (shadow.h_ram & 0xff) && x1 <= (shadow.h_ram >> 8) &&
+	  y >= shadow.v_start && y <= shadow.v_end);
+}
+
+/**
+********************************************************************************
+* @function  void SetXY(unsigned int x0,unsigned int y0,
+*	                unsigned int x1,unsigned int y1)
+* @brief     Set an area to be drawn.
+*            SetWindow() calls bus_hook first ,so whatever is kept back is
+*            drawn before the window is set.
+********************************************************************************
+**/
+static void SetXY(unsigned int x0,unsigned int y0,
+		  unsigned int x1,unsigned int y1)
+{
+  SetWindow(x0, y0, x1, y1);
+  SetCursor(x0, y0);
+}
+
+/**
+********************************************************************************
+* @function  void SetSpan(unsigned int x0,unsigned int x1,unsigned int y)
+* @brief     Get ready to write the pixels x0 ~ x1 of row y.
+*            When they are in the current window ,only the cursor is moved.
+*            Otherwise the window is opened to the full screen first ,so the
+*            following spans and points only need to move the cursor.
+*            Note: x0 <= x1
+********************************************************************************
+**/
+static void SetSpan(unsigned int x0,unsigned int x1,unsigned int y)
+{
+  BusHook();
+
+  if(InWindow(x0, x1, y) == 0)
+    {
+      SetWindow(0, 0, display_x - 1, display_y - 1);
+    }
+  SetCursor(x0, y);
+}
+
+/**
+********************************************************************************
+* @function  void SetRun_V(unsigned int x,unsigned int y0,unsigned int y1)
+* @brief     Get ready to write the pixels y0 ~ y1 of column x.
+*            Like SetSpan() ,but for the vertical entry mode (LCD_ENTRY_V).
+*            Note: y0 <= y1
+********************************************************************************
+**/
+static void SetRun_V(unsigned int x,unsigned int y0,unsigned int y1)
+{
+  BusHook();
+
+  if(InWindow(x, x, y0) == 0 || y1 > shadow.v_end)
+    {
+      SetWindow(0, 0, display_x - 1, display_y - 1);
+    }
+  SetCursor(x, y0);
+}
+
+/**
+********************************************************************************
+* @function  void _FillWindow(unsigned int x0,unsigned int y0,
+*                             unsigned int x1,unsigned int y1,
+*                             unsigned int color)
+* @brief     Fill an area with one color.
+*            The window is set only once ,then all the pixels are written
+*            by lcd_fill_pixels().
+*            Note: x0 <= x1 , y0 <= y1
+********************************************************************************
+**/
+static void _FillWindow(unsigned int x0,unsigned int y0,
+			unsigned int x1,unsigned int y1,
+			unsigned int color)
+{
+  SetXY(x0, y0, x1, y1);
+  lcd_fill_pixels(color, (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1));
+}
+
+/**
+********************************************************************************
+* @variable clip , clip_stack , clip_depth
+* @brief    Clip rectangle.
+*           Every drawing command only changes the pixels in 'clip' ,the
+*           parts of shapes outside it (or outside the screen) are cut off
+*           instead of dropping the command. 'clip' is the screen at first ,
+*           AT+cp pushes a smaller one ,AT+cP pops it.
+*           An empty clip has x0 > x1.
+********************************************************************************
+**/
+#define CLIP_MAX_DEPTH 8
+
+struct _clip
+{
+  int x0;
+  int y0;
+  int x1;
+  int y1;
+};
+
+static struct _clip clip = {0, 0, 239, 319};
+static struct _clip clip_stack[CLIP_MAX_DEPTH];
+static unsigned int clip_depth = 0;
+
+/**
+********************************************************************************
+* @micro    CMD_MAX_COORD
+* @brief    Limit of |x| ,|y| and the radius of the drawing commands.
+*           The shapes are cut to the clip rectangle ,but their math still
+*           runs over the whole shape. A command with a value out of
+*           -CMD_MAX_COORD ~ CMD_MAX_COORD is dropped ,so the products
+*           (r * r ,dx * dy ...) stay in 32 bits and the loops stay short.
+********************************************************************************
+**/
+#define CMD_MAX_COORD 4095
+
+/**
+********************************************************************************
+* @function  int _CoordArgs(unsigned char **args ,int arg_num ,int *v)
+* @brief     Get 'arg_num' coordinates or radii of a drawing command to 'v'.
+* @return    0  --> succeed
+*            -1 --> a value is out of -CMD_MAX_COORD ~ CMD_MAX_COORD
+********************************************************************************
+**/
+static int _CoordArgs(unsigned char **args ,int arg_num ,int *v)
+{
+  int count;
+
+  for(count = 0; count < arg_num; count++)
+    {
+      v[count] = str_to_int(*(args + count));
+      if(v[count] > CMD_MAX_COORD || v[count] < -CMD_MAX_COORD)
+	{
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  int _ClipRect(int *x0 ,int *y0 ,int *x1 ,int *y1)
+* @brief     Cut a rectangle to the clip rectangle.
+*            Note: *x0 <= *x1 , *y0 <= *y1
+* @return    0  --> something is left
+*            -1 --> all outside
+********************************************************************************
+**/
+static int _ClipRect(int *x0 ,int *y0 ,int *x1 ,int *y1)
+{
+  if(*x0 > clip.x1 || *x1 < clip.x0 || *y0 > clip.y1 || *y1 < clip.y0)
+    {
+      return -1;
+    }
+  if(*x0 < clip.x0)
+    {
+      *x0 = clip.x0;
+    }
+  if(*y0 < clip.y0)
+    {
+      *y0 = clip.y0;
+    }
+  if(*x1 > clip.x1)
+    {
+      *x1 = clip.x1;
+    }
+  if(*y1 > clip.y1)
+    {
+      *y1 = clip.y1;
+    }
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  int _ClipInside(int x0 ,int y0 ,int x1 ,int y1)
+* @return    1 --> the rectangle is all in the clip rectangle
+*            0 --> no
+********************************************************************************
+**/
+static int _ClipInside(int x0 ,int y0 ,int x1 ,int y1)
+{
+  return (x0 >= clip.x0 && x1 <= clip.x1 && y0 >= clip.y0 && y1 <= clip.y1);
+}
+
+/**
+********************************************************************************
+* @function  unsigned int _ClipCode(int x ,int y)
+* @brief     Cohen-Sutherland region code of a point :
+*            bit 0 left ,bit 1 right ,bit 2 above ,bit 3 below the clip.
+********************************************************************************
+**/
+static unsigned int _ClipCode(int x ,int y)
+{
+  unsigned int code = 0;
+
+  if(x < clip.x0)
+    {
+      code |= 1;
+    }
+  else if(x > clip.x1)
+    {
+      code |= 2;
+    }
+  if(y < clip.y0)
+    {
+      code |= 4;
+    }
+  else if(y > clip.y1)
+    {
+      code |= 8;
+    }
+  return code;
+}
+
+/**
+********************************************************************************
+* @function  int _ClipLine(int *x0 ,int *y0 ,int *x1 ,int *y1)
+* @brief     Cut a line to the clip rectangle (Cohen-Sutherland).
+*            Both ends on the same outer side of the clip is rejected at
+*            once ,no pixel is looked at.
+* @return    0  --> something is left ,the ends are moved into the clip
+*            -1 --> all outside
+********************************************************************************
+**/
+static int _ClipLine(int *x0 ,int *y0 ,int *x1 ,int *y1)
+{
+  unsigned int code0, code1, code;
+  int64_t x, y, dx, dy;    /* dx * (y - y0) may not fit in 32 bits */
+
+  code0 = _ClipCode(*x0, *y0);
+  code1 = _ClipCode(*x1, *y1);
+  while((code0 | code1) != 0)
+    {
+      if((code0 & code1) != 0)
+	{
+	  return -1;
+	}
+
+      code = (code0 != 0)? code0 : code1;
+      dx = *x1 - *x0;
+      dy = *y1 - *y0;
+      if((code & 8) != 0)
+	{
+	  y = clip.y1;
+	  x = *x0 + dx * (y - *y0) / dy;
+	}
+      else if((code & 4) != 0)
+	{
+	  y = clip.y0;
+	  x = *x0 + dx * (y - *y0) / dy;
+	}
+      else if((code & 2) != 0)
+	{
+	  x = clip.x1;
+	  y = *y0 + dy * (x - *x0) / dx;
+	}
+      else
+	{
+	  x = clip.x0;
+	  y = *y0 + dy * (x - *x0) / dx;
+	}
+
+      if(code == code0)
+	{
+	  *x0 = (int)x;
+	  *y0 = (int)y;
+	  code0 = _ClipCode(*x0, *y0);
+	}
+      else
+	{
+	  *x1 = (int)x;
+	  *y1 = (int)y;
+	  code1 = _ClipCode(*x1, *y1);
+	}
+    }
+  return 0;
+}
+
+
+/**
+********************************************************************************
+* @function  void LCD_Init(unsigned char **args, int arg_num)
+* @brief     Initialize LCD (HX8347A) ,ignore 'args' 
+********************************************************************************
+**/
+static void LCD_Init_hx8347a(unsigned char **args, int arg_num)
+{
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+  unsigned char *p = *args;
+  if(arg_num != 0) /* This function does not need parameters */
+    {
+      p++;
+      return ;
+    }
+
+  BusHook();        /* the drawings kept back go first */
+  shadow.valid = 0; /* the window registers are reset below */
+  shadow.entry = LCD_ENTRY_H;
+  shadow.scroll = 0;
+
+  GPIO_ResetBits(GPIOD, GPIO_Pin_2);
+  Delayms(4);					   
+  GPIO_SetBits(GPIOD, GPIO_Pin_2 );		 	 
+  Delayms(10);
+
+  Write_Command_Data(0x0000,0x0001);
+  Write_Command_Data(0x0003,0xA8A4);
+  Write_Command_Data(0x000C,0x0000);
+  Write_Command_Data(0x000D,0x080C);
+  Write_Command_Data(0x000E,0x2B00);
+  Write_Command_Data(0x001E,0x00B7);
+  Write_Command_Data(0x0001,0x2B3F);
+  Write_Command_Data(0x0002,0x0600);
+  Write_Command_Data(0x0010,0x0000);
+  Write_Command_Data(0x0011,LCD_ENTRY_H);
+  Write_Command_Data(0x0005,0x0000);
+  Write_Command_Data(0x0006,0x0000);
+  Write_Command_Data(0x0016,0xEF1C);
+  Write_Command_Data(0x0017,0x0003);
+  Write_Command_Data(0x0007,0x0233);
+  Write_Command_Data(0x000B,0x0000);
+  Write_Command_Data(0x000F,0x0000);
+  Write_Command_Data(0x0041,0x0000);
+  Write_Command_Data(0x0042,0x0000);
+  Write_Command_Data(0x0048,0x0000);
+  Write_Command_Data(0x0049,0x013F);
+  Write_Command_Data(0x004A,0x0000);
+  Write_Command_Data(0x004B,0x0000);
+  Write_Command_Data(0x0044,0xEF00);
+  Write_Command_Data(0x0045,0x0000);
+  Write_Command_Data(0x0046,0x013F);
+  Write_Command_Data(0x0030,0x0707);
+  Write_Command_Data(0x0031,0x0204);
+  Write_Command_Data(0x0032,0x0204);
+  Write_Command_Data(0x0033,0x0502);
+  Write_Command_Data(0x0034,0x0507);
+  Write_Command_Data(0x0035,0x0204);
+  Write_Command_Data(0x0036,0x0204);
+  Write_Command_Data(0x0037,0x0502);
+  Write_Command_Data(0x003A,0x0302);
+  Write_Command_Data(0x003B,0x0302);
+  Write_Command_Data(0x0023,0x0000);
+  Write_Command_Data(0x0024,0x0000);
+  Write_Command_Data(0x0025,0x8000);
+  Write_Command_Data(0x004f,0x0000);
+  Write_Command_Data(0x004e,0x0000);
+  Write_Command(0x0022);
+ if(usart1.debug == 1)
+   {
+     usart1.printf(&usart1,"LCD is initialized.\n");
+   }
+}
+
+
+
+/**
+********************************************************************************
+* @variable frame , frame_op , frame_text
+* @brief    Frame display list.
+*           Between AT+BF and AT+EF the filled rectangles ,circles ,round
+*           rectangles ,lines ,texts and screen fills are not drawn ,they are
+*           put in this list with their colors. At AT+EF the list is
+*           composited in 16x16 tiles and every touched tile is sent once.
+*           Other drawings in a frame are done at once ,the list is drawn
+*           before them by bus_hook. A drawing that does not fit in the list
+*           is also done at once.
+*           frame.active --> 1 : between AT+BF and AT+EF
+*           frame.count  --> operations in frame_op[]
+*           frame.text   --> characters used in frame_text[]
+*           frame.busy   --> 1 : the list is being drawn
+********************************************************************************
+**/
+#define FRAME_MAX_OP   48
+#define FRAME_MAX_TEXT 256
+
+#define FRAME_RECT  0    /* x0 ,y0 ,x1 ,y1 filled with 'front'          */
+#define FRAME_RRECT 1    /* x0 ,y0 ,x1 ,y1 ,round corner radius 'r'     */
+#define FRAME_LINE  2    /* from (x0 ,y0) to (x1 ,y1)                   */
+#define FRAME_TEXT  3    /* 'len' characters at frame_text[r] ,the text
+			    cell at (x0 ,y0) ,font 'font' ,text mode 'mode' */
+
+struct _frame_op
+{
+  unsigned char type;
+  unsigned char mode;
+  unsigned short x0;
+  unsigned short y0;
+  unsigned short x1;
+  unsigned short y1;
+  unsigned short r;
+  unsigned short len;
+  unsigned short front;
+  unsigned short back;
+  const unsigned char *font;
+};
+
+struct _frame
+{
+  unsigned char active;
+  unsigned char busy;
+  unsigned int count;
+  unsigned int text;
+};
+
+static struct _frame frame;
+static struct _frame_op frame_op[FRAME_MAX_OP];
+static unsigned char frame_text[FRAME_MAX_TEXT];
+
+/**
+********************************************************************************
+* @function  int _FrameAdd(unsigned char type ,unsigned int x0 ,unsigned int y0,
+*                          unsigned int x1 ,unsigned int y1 ,unsigned int r,
+*                          unsigned int color)
+* @brief     Put an operation in the frame display list.
+*            'color' is the fill color ,back_color and the current font are
+*            also kept.
+* @return    0  --> the operation is in the list ,do not draw it now
+*            -1 --> no frame or the list is full ,draw it now
+********************************************************************************
+**/
+static int _FrameAdd(unsigned char type ,unsigned int x0 ,unsigned int y0,
+		     unsigned int x1 ,unsigned int y1 ,unsigned int r,
+		     unsigned int color)
+{
+  struct _frame_op *op;
+
+  if(frame.active == 0 || frame.busy != 0 || frame.count >= FRAME_MAX_OP)
+    {
+      return -1;
+    }
+
+  op = &frame_op[frame.count++];
+  op->type = type;
+  op->mode = 0;
+  op->x0 = (unsigned short)x0;
+  op->y0 = (unsigned short)y0;
+  op->x1 = (unsigned short)x1;
+  op->y1 = (unsigned short)y1;
+  op->r = (unsigned short)r;
+  op->len = 0;
+  op->front = (unsigned short)color;
+  op->back = (unsigned short)back_color;
+  op->font = cfont.font;
+  return 0;
+}
+
+/**
+********************************************************************************
+* @variable cull , cull_rect , cull_tmp , pixels_culled
+* @brief    Culling queue of opaque rectangle fills (FillRectangle ,
+*           FillScreen ,ClearScreen).
+*           A fill is not drawn at once ,it waits in cull_rect[] with its
+*           color. A new fill cuts the parts it covers out of the waiting
+*           ones (a rectangle minus a rectangle is at most 4 rectangles) ,
+*           the covered pixels are never sent.
+*           The queue is drawn by bus_hook (from the window functions ,before
+*           the next drawing sets its window) ,by BeginFrame ,and by
+*           Background() when no fill came for CULL_DELAY_MS.
+*           cull.count --> rectangles in cull_rect[]
+*           cull.time  --> GetTickms() of the last fill
+*           cull.busy  --> 1 : the queue is being drawn
+*           pixels_culled --> pixels not sent ,reported by AT+gS
+********************************************************************************
+**/
+#define CULL_MAX_RECT 8
+#define CULL_DELAY_MS 5
+
+struct _cull_rect
+{
+  unsigned short x0;
+  unsigned short y0;
+  unsigned short x1;
+  unsigned short y1;
+  unsigned short color;
+};
+
+struct _cull
+{
+  unsigned int count;
+  uint32_t time;
+  unsigned char busy;
+};
+
+static struct _cull cull;
+static struct _cull_rect cull_rect[CULL_MAX_RECT];
+static struct _cull_rect cull_tmp[CULL_MAX_RECT * 4];
+static unsigned long pixels_culled = 0;
+
+/**
+********************************************************************************
+* @function  void _CullFlush(void)
+* @brief     Draw the culling queue and empty it.
+********************************************************************************
+**/
+static void _CullFlush(void)
+{
+  unsigned int i, n;
+
+  if(cull.busy != 0 || cull.count == 0)
+    {
+      return;
+    }
+  cull.busy = 1;
+  n = cull.count;
+  cull.count = 0;
+  for(i = 0; i < n; i++)
+    {
+      _FillWindow(cull_rect[i].x0, cull_rect[i].y0,
+		  cull_rect[i].x1, cull_rect[i].y1, cull_rect[i].color);
+    }
+  cull.busy = 0;
+}
+
+/**
+********************************************************************************
+* @function  int _CullAdd(unsigned int x0 ,unsigned int y0,
+*                         unsigned int x1 ,unsigned int y1,
+*                         unsigned int color)
+* @brief     Put an opaque fill in the culling queue.
+*            The parts of the waiting fills under it are cut out. When the
+*            pieces left do not fit in the queue ,they are drawn now.
+*            Note: x0 <= x1 , y0 <= y1
+* @return    0  --> the fill is in the queue ,do not draw it now
+*            -1 --> in a frame (the display list culls by itself) ,draw it now
+********************************************************************************
+**/
+static int _CullAdd(unsigned int x0 ,unsigned int y0,
+		    unsigned int x1 ,unsigned int y1,
+		    unsigned int color)
+{
+  unsigned int i, n, ix0, iy0, ix1, iy1;
+  struct _cull_rect *r;
+
+  if(frame.active != 0 || cull.busy != 0)
+    {
+      return -1;
+    }
+
+  n = 0;
+  for(i = 0; i < cull.count; i++)
+    {
+      r = &cull_rect[i];
+      ix0 = (r->x0 > x0)? r->x0 : x0;
+      iy0 = (r->y0 > y0)? r->y0 : y0;
+      ix1 = (r->x1 < x1)? r->x1 : x1;
+      iy1 = (r->y1 < y1)? r->y1 : y1;
+      if(ix0 > ix1 || iy0 > iy1)    /* not covered ,keep it */
+	{
+	  cull_tmp[n++] = *r;
+	  continue;
+	}
+
+      pixels_culled += (unsigned long)(ix1 - ix0 + 1) * (iy1 - iy0 + 1);
+      if(iy0 > r->y0)    /* above */
+	{
+	  cull_tmp[n] = *r;
+	  cull_tmp[n++].y1 = (unsigned short)(iy0 - 1);
+	}
+      if(iy1 < r->y1)    /* below */
+	{
+	  cull_tmp[n] = *r;
+	  cull_tmp[n++].y0 = (unsigned short)(iy1 + 1);
+	}
+      if(ix0 > r->x0)    /* left */
+	{
+	  cull_tmp[n] = *r;
+	  cull_tmp[n].y0 = (unsigned short)iy0;
+	  cull_tmp[n].y1 = (unsigned short)iy1;
+	  cull_tmp[n++].x1 = (unsigned short)(ix0 - 1);
+	}
+      if(ix1 < r->x1)    /* right */
+	{
+	  cull_tmp[n] = *r;
+	  cull_tmp[n].y0 = (unsigned short)iy0;
+	  cull_tmp[n].y1 = (unsigned short)iy1;
+	  cull_tmp[n++].x0 = (unsigned short)(ix1 + 1);
+	}
+    }
+
+  if(n + 1 > CULL_MAX_RECT)    /* too many pieces ,draw them now */
+    {
+      cull.busy = 1;
+      cull.count = 0;
+      for(i = 0; i < n; i++)
+	{
+	  _FillWindow(cull_tmp[i].x0, cull_tmp[i].y0,
+		      cull_tmp[i].x1, cull_tmp[i].y1, cull_tmp[i].color);
+	}
+      cull.busy = 0;
+      n = 0;
+    }
+  else
+    {
+      memcpy(cull_rect, cull_tmp, n * sizeof(cull_rect[0]));
+    }
+
+  r = &cull_rect[n];
+  r->x0 = (unsigned short)x0;
+  r->y0 = (unsigned short)y0;
+  r->x1 = (unsigned short)x1;
+  r->y1 = (unsigned short)y1;
+  r->color = (unsigned short)color;
+  cull.count = n + 1;
+  cull.time = GetTickms();
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  void FillScreen(unsigned char **args, int arg_num)
+* @brief     Fill the LCD screen with the color passed by the parameter 'args'.
+********************************************************************************
+**/
+static void FillScreen(unsigned char **args, int arg_num)
+{
+  unsigned int i;
+  unsigned int tmp[3];  /* store the color or RGB data*/
+  unsigned int color;
+
+  switch(arg_num)  /* set color ,depends on arg_num*/
+    {
+    case 1:        /* 1 parameter --> color */
+      tmp[0] = str_to_uint(*args); /* change string to integer */
+      color  = tmp[0];
+      break;
+    case 3:        /* 3 parameters , RGB data --> color */
+      for(i = 0 ; i < 3 ; i++)
+	{
+	  tmp[i] = str_to_uint(*(args + i));
+	}
+      color = RGB_to_color(tmp[0],tmp[1],tmp[2]);
+      break;
+    case 0:        /* no parameter , set default value */
+    default:       /* wrong parameters , set default value */
+      color = back_color;
+      break;
+    }
+
+  /* only the clip rectangle is filled */
+  if(clip.x0 > clip.x1)
+    {
+      return;
+    }
+  if(_FrameAdd(FRAME_RECT, clip.x0, clip.y0, clip.x1, clip.y1, 0, color) != 0 &&
+     _CullAdd(clip.x0, clip.y0, clip.x1, clip.y1, color) != 0)
+    {
+      _FillWindow(clip.x0, clip.y0, clip.x1, clip.y1, color);
+    }
+  screen_epoch++;
+}
+
+/**
+********************************************************************************
+* @function  void ClearScreen(unsigned char **args, int arg_num)
+* @brief     Fill the LCD screen with the back_color.
+********************************************************************************
+**/
+static void ClearScreen(unsigned char **args, int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+
+  /* only the clip rectangle is cleared */
+  if(clip.x0 > clip.x1)
+    {
+      return;
+    }
+  if(_FrameAdd(FRAME_RECT, clip.x0, clip.y0, clip.x1, clip.y1, 0,
+	       back_color) != 0 &&
+     _CullAdd(clip.x0, clip.y0, clip.x1, clip.y1, back_color) != 0)
+    {
+      _FillWindow(clip.x0, clip.y0, clip.x1, clip.y1, back_color);
+    }
+  screen_epoch++;
+}
+
+
+/**
+********************************************************************************
+* @function  void SetFrontColor(unsigned char **args, int arg_num)
+* @brief     Front Color is used for area to be drawn.
+********************************************************************************
+**/
+static void SetFrontColor(unsigned char **args, int arg_num)
+{
+  unsigned int color_r,color_g,color_b;
+
+  switch(arg_num) /* set front_color ,depends on args */
+    {
+    case 1:  /* 1 parameters */
+      front_color = str_to_uint(*args);
+      break;
+    case 3: /* 3 parameters , RGB */
+      color_r = str_to_uint(*args);
+      color_g = str_to_uint(*(args+1));
+      color_b = str_to_uint(*(args+2));
+      front_color = RGB_to_color(color_r,color_g,color_b);
+      break;
+    default:
+      break;
+    }
+}
+
+
+/**
+********************************************************************************
+* @function  void GetFrontColor(unsigned char **args, int arg_num)
+* @brief     print the front_color to the usart1.
+********************************************************************************
+**/
+static void GetFrontColor_uart1(unsigned char **args, int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return;
+    }
+  usart1.printf(&usart1,"front_color is %d\n",front_color);
+}
+
+
+/**
+********************************************************************************
+* @function  void SetBackColor(unsigned char **args, int arg_num)
+* @brief     Back color is for blank area.
+********************************************************************************
+**/
+static void SetBackColor(unsigned char **args, int arg_num)
+{
+  unsigned int color_r,color_g,color_b;
+
+  switch(arg_num) /* set back_color ,depends on args */
+    {
+    case 1:  /* 1 parameters */
+      back_color = str_to_uint(*args);
+      break;
+    case 3: /* 3 parameters , RGB */
+      color_r = str_to_uint(*args);
+      color_g = str_to_uint(*(args+1));
+      color_b = str_to_uint(*(args+2));
+      back_color = RGB_to_color(color_r,color_g,color_b);
+      break;
+    default:
+      break;      
+    }
+}
+
+/**
+********************************************************************************
+* @function  void GetBackColor(unsigned char **args, int arg_num)
+* @brief     print the back_color to the usart1.
+********************************************************************************
+**/
+static void GetBackColor_uart1(unsigned char **args, int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return;
+    }
+  usart1.printf(&usart1,"back_color is %d\n",back_color);
+}
+
+/**
+********************************************************************************
+* @function  void _DrawPoint(int x,int y)
+* @brief     Draw a point ,nothing is drawn outside the clip rectangle.
+********************************************************************************
+**/
+static void _DrawPoint(int x,int y)
+{
+  if(x < clip.x0 || x > clip.x1 || y < clip.y0 || y > clip.y1)
+    {
+      return;
+    }
+  SetSpan(x, x, y);
+  Write_Data(front_color);
+}
+
+/**
+********************************************************************************
+* @function  void DrawPoint(unsigned char **args ,int arg_num)
+* @brief     Get the point location and call the _DrawPoint.
+********************************************************************************
+**/
+static void DrawPoint(unsigned char **args ,int arg_num)
+{
+  if(arg_num == 2)
+    {
+      _DrawPoint(str_to_int(*args) , str_to_int(*(args + 1)));
+    }
+}
+
+/**
+********************************************************************************
+* @function  static void _DrawLine_H(unsigned int x0, unsigned int y0 ,
+*			             unsigned int x1 ,unsigned int y1)
+* @brief     Draw a horizontal line.
+********************************************************************************
+**/
+static void _DrawLine_H(unsigned int x0, unsigned int y0 ,
+			unsigned int x1 ,unsigned int y1)
+{
+  unsigned int l;
+  /* variable p is only used to avoid warning 'unused parameter'*/
+  unsigned int p = y1;
+  p++;
+
+  if(_FrameAdd(FRAME_LINE, x0, y0, x1, y0, 0, front_color) == 0)
+    {
+      return;
+    }
+
+  if(x0 > x1)
+    {
+      SetSpan(x1,x0,y0);
+      l = x0 - x1 + 1;
+    }
+  else
+    {
+      SetSpan(x0,x1,y0);
+      l = x1 - x0 + 1;
+    }
+
+  lcd_fill_pixels(front_color, l);
+}
+
+/**
+********************************************************************************
+* @function  _DrawLine_V(unsigned int x0, unsigned int y0 ,
+			unsigned int x1 ,unsigned int y1)
+* @brief     Draw a vertical line.
+********************************************************************************
+**/
+static void _DrawLine_V(unsigned int x0, unsigned int y0 ,
+			unsigned int x1 ,unsigned int y1)
+{
+  unsigned int l;
+  /* variable p is only used to avoid warning 'unused parameter'*/
+  unsigned int p = x1;
+  p++;
+
+  if(_FrameAdd(FRAME_LINE, x0, y0, x0, y1, 0, front_color) == 0)
+    {
+      return;
+    }
+
+  if(y0 > y1)
+    {
+      SetXY(x0,y1,x0,y0);      
+      l = y0 - y1 + 1;
+    }
+  else
+    {
+      SetXY(x0,y0,x0,y1);      
+      l = y1 - y0 + 1;
+    }
+
+  lcd_fill_pixels(front_color, l);
+}
+
+/**
+********************************************************************************
+* @function  void _DrawLine_A(unsigned int x0, unsigned int y0 ,
+*                	       unsigned int x1 ,unsigned int y1)
+* @brief     Draw an ablique line.
+*            Bresenham ,but the pixels are not written one by one.
+*            A shallow line is made of horizontal runs and a steep line of
+*            vertical runs ,each run is sent as one burst after one cursor
+*            move (vertical runs use the LCD_ENTRY_V entry mode).
+********************************************************************************
+**/
+static void _DrawLine_A(unsigned int x0, unsigned int y0 ,
+			unsigned int x1 ,unsigned int y1)
+{
+  int delta_x, delta_y, d, dinc1, dinc2, step;
+  unsigned int tmp, x, y, run_start;
+
+  if(_FrameAdd(FRAME_LINE, x0, y0, x1, y1, 0, front_color) == 0)
+    {
+      return;
+    }
+
+  /* Calculate delta-x and delta-y for initialization */
+  delta_x = (x1 > x0)?(x1 - x0):(x0 - x1);
+  delta_y = (y1 > y0)?(y1 - y0):(y0 - y1);
+
+  if(delta_x >= delta_y)
+    {
+      /* x is independent variable ,draw from left to right */
+      if(x0 > x1)
+	{
+	  tmp = x0; x0 = x1; x1 = tmp;
+	  tmp = y0; y0 = y1; y1 = tmp;
+	}
+      step = (y1 > y0)? 1 : -1;
+      d = (delta_y << 1) - delta_x;
+      dinc1 = delta_y << 1;
+      dinc2 = (delta_y - delta_x) << 1;
+
+      SetEntry(LCD_ENTRY_H);
+      y = y0;
+      run_start = x0;
+      for(x = x0; x < x1; x++)
+	{
+	  if(d < 0)
+	    {
+	      d += dinc1;
+	    }
+	  else  /* the next pixel is on the next row ,this run ends here */
+	    {
+	      SetSpan(run_start, x, y);
+	      lcd_fill_pixels(front_color, x - run_start + 1);
+	      d += dinc2;
+	      y += step;
+	      run_start = x + 1;
+	    }
+	}
+      SetSpan(run_start, x1, y);
+      lcd_fill_pixels(front_color, x1 - run_start + 1);
+    }
+  else
+    {
+      /* y is independent variable ,draw from top to bottom */
+      if(y0 > y1)
+	{
+	  tmp = x0; x0 = x1; x1 = tmp;
+	  tmp = y0; y0 = y1; y1 = tmp;
+	}
+      step = (x1 > x0)? 1 : -1;
+      d = (delta_x << 1) - delta_y;
+      dinc1 = delta_x << 1;
+      dinc2 = (delta_x - delta_y) << 1;
+
+      SetEntry(LCD_ENTRY_V);
+      x = x0;
+      run_start = y0;
+      for(y = y0; y < y1; y++)
+	{
+	  if(d < 0)
+	    {
+	      d += dinc1;
+	    }
+	  else  /* the next pixel is on the next column ,this run ends here */
+	    {
+	      SetRun_V(x, run_start, y);
+	      lcd_fill_pixels(front_color, y - run_start + 1);
+	      d += dinc2;
+	      x += step;
+	      run_start = y + 1;
+	    }
+	}
+      SetRun_V(x, run_start, y1);
+      lcd_fill_pixels(front_color, y1 - run_start + 1);
+      SetEntry(LCD_ENTRY_H);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _DrawLine(int x0 ,int y0 ,int x1 ,int y1)
+* @brief     Cut a line to the clip rectangle and draw what is left with
+*            the horizontal ,vertical or ablique line function.
+********************************************************************************
+**/
+static void _DrawLine(int x0 ,int y0 ,int x1 ,int y1)
+{
+  if(_ClipLine(&x0, &y0, &x1, &y1) != 0)
+    {
+      return;
+    }
+
+  if(x0 == x1)    /* Draw a vertical line.*/
+    {
+      _DrawLine_V(x0, y0, x1, y1);
+    }
+  else if(y0 == y1)    /* Draw a horizontal line.*/
+    {
+      _DrawLine_H(x0, y0, x1, y1);
+    }
+  else /* Draw an ablique line.*/
+    {
+      _DrawLine_A(x0, y0, x1, y1);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void void _TestDrawLine()
+* @brief     print some lines on the screen.
+********************************************************************************
+**/
+static void _TestDrawLine(void)
+{
+  unsigned int location = 20;
+
+  _DrawLine_H(20,150,220,150);
+  _DrawLine_V(120,10,120,310);
+  while(location < display_y)
+    {
+      _DrawLine_A(20,150,120,location);
+      location += 25;
+    }
+}
+
+
+/**
+********************************************************************************
+* @function  void DrawLine(unsigned char **args ,int arg_num)
+* @brief     Get the line parameters and call the draw_line functions.
+********************************************************************************
+**/
+static void DrawLine(unsigned char **args ,int arg_num)
+{
+  int location[4];
+  
+  if(arg_num != 4)
+    {
+#ifdef LCD_DEBUG
+      if(arg_num == 0)
+	{
+	  _TestDrawLine();
+	  return;
+	}
+#endif
+      return;      
+    }
+
+  if(_CoordArgs(args, 4, location) != 0)
+    {
+      return;
+    }
+
+  /* the parts out of the clip rectangle are cut off */
+  _DrawLine(location[0],location[1],location[2],location[3]);
+}
+
+/**
+********************************************************************************
+* @function  _DrawRectangle(int x0, int y0, int x1, int y1)
+* @brief     Draw a Rectangle.
+********************************************************************************
+**/
+static void _DrawRectangle(int x0, int y0, int x1, int y1)
+{
+  _DrawLine(x0 ,y0 ,x1 ,y0);
+  _DrawLine(x0 ,y1 ,x1 ,y1);
+  _DrawLine(x0 ,y0 ,x0 ,y1);
+  _DrawLine(x1 ,y0 ,x1 ,y1);
+}
+
+/**
+********************************************************************************
+* @function  void _Test_DrawRectangle(void)
+* @brief     print some Rectangles on LCD
+********************************************************************************
+**/
+static void _Test_DrawRectangle(void)
+{
+  unsigned int x0 = 0,y0 = 0 ,x1 = display_x - 1 ,y1 = display_y - 1;
+  
+  while( (x0 < x1) && (y0 < y1) )
+    {
+      _DrawRectangle(x0 ,y0 ,x1 ,y1);
+      x0 += 10;
+      x1 -= 10;
+      y0 += 10;
+      y1 -= 10;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void DrawRectangle(unsigned char **args ,int arg_num)
+* @brief     Get the rectangle parameters and call the _DrawRectangle function
+********************************************************************************
+**/
+static void DrawRectangle(unsigned char **args ,int arg_num)
+{
+  int location[4];
+  
+  if(arg_num != 4)
+    {
+#ifdef LCD_DEBUG
+      if(arg_num == 0)
+	{
+	  _Test_DrawRectangle();
+	  return;
+	}
+#endif
+      return;      
+    }
+
+  if(_CoordArgs(args, 4, location) != 0)
+    {
+      return;
+    }
+
+  _DrawRectangle(location[0],location[1],location[2],location[3]);
+}
+
+
+/**
+********************************************************************************
+* @function  void _Draw_Circle(int x, int y ,int radius)
+* @brief     Draw a circle.
+********************************************************************************
+**/
+static void _Draw_Circle(int x, int y ,int radius)
+{
+  int f = 1 - radius;
+  int ddF_x = 1;
+  int ddF_y = -2 * radius;
+  int x1 = 0;
+  int y1 = radius;
+
+  _DrawPoint( x, y + radius);    
+  _DrawPoint( x, y - radius);    
+  _DrawPoint( x + radius, y);    
+  _DrawPoint( x - radius, y);    
+
+  while(x1 < y1)
+    {
+      if(f >= 0) 
+	{
+	  y1--;
+	  ddF_y += 2;
+	  f += ddF_y;
+	}
+      x1++;
+      ddF_x += 2;
+      f += ddF_x;    
+
+      _DrawPoint( x + x1, y + y1);    
+      _DrawPoint( x - x1, y + y1);    
+      _DrawPoint( x + x1, y - y1);    
+      _DrawPoint( x - x1, y - y1);    
+
+      _DrawPoint( x + y1, y + x1);
+      _DrawPoint( x - y1, y + x1);    
+      _DrawPoint( x + y1, y - x1);    
+      _DrawPoint( x - y1, y - x1);    
+    }
+}
+
+/**
+********************************************************************************
+* @function  _Test_DrawCircle(void)
+* @brief     print some circles on LCD
+********************************************************************************
+**/
+static void _Test_DrawCircle(void)
+{
+  unsigned int x = 120, y = 160 , r = 10;
+  int tmp[4];
+
+
+  tmp[0] = (int) x - (int) r;
+  tmp[1] = (int) x + (int) r;
+  tmp[2] = (int) y - (int) r;
+  tmp[3] = (int) y + (int) r;
+
+  while(tmp[0] >= 0 && tmp[1] < (int)display_x && 
+	tmp[2] >= 0 && tmp[3] < (int)display_y)
+    {
+      _Draw_Circle( x, y, r);
+      r += 10;
+      tmp[0] = (int) x - (int) r;
+      tmp[1] = (int) x + (int) r;
+      tmp[2] = (int) y - (int) r;
+      tmp[3] = (int) y + (int) r;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void DrawCircle(unsigned char **args ,int arg_num)
+* @brief     Get parameters and call the _DrawCircle function
+********************************************************************************
+**/
+static void DrawCircle(unsigned char **args ,int arg_num)
+{
+  int tmp[3]; /* (tmp[0],tmp[1]; r = tmp[2]) */
+  if(arg_num != 3)
+    {
+#ifdef LCD_DEBUG
+      if(arg_num == 0)
+	{
+	  _Test_DrawCircle();
+	  return;
+	}
+#endif
+      return;      
+    }
+
+  if(_CoordArgs(args, 3, tmp) != 0)
+    {
+      return;
+    }
+
+  /* radius < 0 ,or the circle is all out of the clip rectangle */
+  if(tmp[2] < 0 ||
+     tmp[0] + tmp[2] < clip.x0 || tmp[0] - tmp[2] > clip.x1 ||
+     tmp[1] + tmp[2] < clip.y0 || tmp[1] - tmp[2] > clip.y1)
+    {
+      return ;
+    }
+  
+  _Draw_Circle(tmp[0], tmp[1], tmp[2]);
+}
+
+/**
+********************************************************************************
+* @function  _DrawRRect(int x0 ,int y0 ,int x1 ,int y1 ,int radius)
+* @brief     Draw a round corner rectangle
+********************************************************************************
+**/
+static void _DrawRRect(int x0 ,int y0 ,int x1 ,int y1 ,int radius)
+{
+  int f = 1 - radius;
+  int ddF_x = 1;
+  int ddF_y = -2 * radius;
+  int step_x = 0;
+  int step_y = radius;
+  
+  int x = x0 + radius;
+  int y = y0 + radius;
+  int offset_x = x1 - x0 - (radius << 1);
+  int offset_y = y1 - y0 - (radius << 1);
+
+  while(step_x < step_y)
+    {
+      if(f >= 0) 
+	{
+	  step_y--;
+	  ddF_y += 2;
+	  f += ddF_y;
+	}
+      step_x++;
+      ddF_x += 2;
+      f += ddF_x;    
+
+      _DrawPoint( x - step_x, y - step_y);    
+      _DrawPoint( x - step_x, y + step_y + offset_y);    
+      _DrawPoint( x + step_x + offset_x, y + step_y + offset_y);    
+      _DrawPoint( x + step_x + offset_x, y - step_y);    
+
+      _DrawPoint( x - step_y, y - step_x);    
+      _DrawPoint( x - step_y, y + step_x + offset_y);    
+      _DrawPoint( x + step_y + offset_x, y + step_x + offset_y);
+      _DrawPoint( x + step_y + offset_x, y - step_x);    
+    }
+  _DrawLine((x0 + radius), y0, (x1 - radius), y0);
+  _DrawLine((x0 + radius), y1, (x1 - radius), y1);
+  _DrawLine(x0, (y0 + radius), x0, (y1 - radius));
+  _DrawLine(x1, (y0 + radius), x1, (y1 - radius));
+
+}
+
+
+/**
+********************************************************************************
+* @function  void _Test_DrawRoundRect(void)
+* @brief     Draw some round corner rectangles.
+********************************************************************************
+**/
+static void _Test_DrawRoundRect(void)
+{
+  unsigned int x0 = 0,y0 = 0 ,x1 = display_x - 1 ,y1 = display_y - 1;
+  unsigned int radius = 60;
+  while( (x0 < x1) && (y0 < y1) && (radius >= 5))
+    {
+      _DrawRRect(x0 ,y0 ,x1 ,y1, radius);
+      x0 += 10;
+      x1 -= 10;
+      y0 += 10;
+      y1 -= 10;
+      radius = (x1 - x0) >> 2;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void DrawRectangle(unsigned char **args ,int arg_num)
+* @brief     Get parameters and call _DrawRRect functions.
+********************************************************************************
+**/
+static void DrawRoundRect(unsigned char **args ,int arg_num)
+{
+  int location[5] ,tmp;
+  int delta_x,delta_y;
+  
+  if(arg_num != 5 && arg_num != 4)
+    {
+#ifdef LCD_DEBUG
+      if(arg_num == 0)
+	{
+	  _Test_DrawRoundRect();
+	  return;
+	}
+#endif
+      return;      
+    }
+
+  if(_CoordArgs(args, arg_num, location) != 0)
+    {
+      return;
+    }
+
+  if(location[0] > location[2])
+    {
+      tmp = location[0];
+      location[0] = location[2];
+      location[2] = tmp;
+    }
+
+  if(location[1] > location[3])
+    {
+      tmp = location[1];
+      location[1] = location[3];
+      location[3] = tmp;
+    }
+  
+  delta_x = location[2] - location[0];
+  delta_y = location[3] - location[1];
+
+  if(arg_num == 4)
+    {
+      location[4] = (delta_x < delta_y)?(delta_x >> 2):(delta_y >> 2);
+    }
+  else if(location[4] < 0 ||
+	  (location[4] << 1) > delta_x || (location[4] << 1) > delta_y)
+    {
+      return;
+    }
+
+  _DrawRRect(location[0],location[1],location[2],location[3],location[4]);
+}
+
+
+/**
+********************************************************************************
+* @typedef   span_func_t
+* @brief     A span sink ,it gets the filled area of a shape piece by piece.
+*            Each call covers the pixels x0 ~ x1 of the rows y ~ y + h - 1.
+*            Span generators (_RoundRectSpans ...) call it once for every
+*            covered row ,consecutive rows with the same pixels are merged
+*            into one call with h > 1.
+*            The spans are not clipped ,a shape may give spans out of the
+*            screen and the sink cuts them.
+********************************************************************************
+**/
+typedef void (*span_func_t)(int x0, int x1, int y, int h);
+
+/**
+********************************************************************************
+* @function  void _FillSpans(int x0, int x1, int y, int h)
+* @brief     Span sink that fills with front_color.
+*            The span is cut to the clip rectangle first.
+*            One row is one cursor move and one burst ,
+*            several rows are one window fill.
+********************************************************************************
+**/
+static void _FillSpans(int x0, int x1, int y, int h)
+{
+  int y1 = y + h - 1;
+
+  if(_ClipRect(&x0, &y, &x1, &y1) != 0)
+    {
+      return;
+    }
+  h = y1 - y + 1;
+
+  if(h == 1)
+    {
+      SetSpan(x0, x1, y);
+      lcd_fill_pixels(front_color, x1 - x0 + 1);
+    }
+  else
+    {
+      _FillWindow(x0, y, x1, y + h - 1, front_color);
+    }
+}
+
+/**
+********************************************************************************
+* @variable brush , brush_bits , brush_user , brush_words , brush_front ,
+*           brush_back , brush_valid
+* @brief    Pattern brush of the area fills (AT+fr ,AT+fc ,AT+fR ,AT+fp ,
+*           AT+ft ,AT+fe ,AT+fa) ,selected by AT+pb ,uploaded by AT+pu.
+*           A pattern is 8 x 8 ,a set bit is front_color ,a clear bit is
+*           back_color ,bit 7 is the left pixel. It is fixed to the screen
+*           (pixel (x ,y) uses the bit x & 7 of the row y & 7) ,so the fills
+*           next to each other join.
+*           brush_words[row][odd][n] is the pattern row pre-expanded to
+*           pixel pairs ready for 32 bit stores : the pixels (2n + odd) & 7
+*           and (2n + 1 + odd) & 7 ,so a span starting at any x is built a
+*           word at a time. The table is rebuilt only when the pattern or
+*           one of the two colors changed.
+********************************************************************************
+**/
+#define BRUSH_SOLID   0
+#define BRUSH_STIPPLE 1    /* every other pixel */
+#define BRUSH_HATCH   2    /* '/' lines */
+#define BRUSH_CROSS   3    /* 'X' lines */
+#define BRUSH_CHECKER 4    /* 4 x 4 squares */
+#define BRUSH_USER    5    /* uploaded by AT+pu */
+
+static const unsigned char brush_bits[BRUSH_USER][8] =
+  {
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff},
+    {0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55},
+    {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80},
+    {0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81},
+    {0xf0, 0xf0, 0xf0, 0xf0, 0x0f, 0x0f, 0x0f, 0x0f}
+  };
+
+static unsigned char brush = BRUSH_SOLID;
+static unsigned char brush_user[8] = {0xaa, 0x55, 0xaa, 0x55,
+				      0xaa, 0x55, 0xaa, 0x55};
+static uint32_t brush_words[8][2][4];
+static unsigned int brush_front = 0, brush_back = 0;
+static unsigned char brush_valid = 0;
+
+/**
+********************************************************************************
+* @function  void _UpdateBrush(void)
+* @brief     Rebuild brush_words[] if the pattern ,front_color or back_color
+*            changed.
+********************************************************************************
+**/
+static void _UpdateBrush(void)
+{
+  const unsigned char *bits;
+  unsigned int row, odd, n, p0, p1;
+  uint32_t c0, c1;
+
+  if(brush_valid != 0 && brush_front == front_color &&
+     brush_back == back_color)
+    {
+      return;
+    }
+
+  bits = (brush == BRUSH_USER)? brush_user : brush_bits[brush];
+  for(row = 0; row < 8; row++)
+    {
+      for(odd = 0; odd < 2; odd++)
+	{
+	  for(n = 0; n < 4; n++)
+	    {
+	      p0 = ((n << 1) + odd) & 0x07;
+	      p1 = ((n << 1) + 1 + odd) & 0x07;
+	      c0 = (((bits[row] << p0) & 0x80) != 0)? front_color : back_color;
+	      c1 = (((bits[row] << p1) & 0x80) != 0)? front_color : back_color;
+	      brush_words[row][odd][n] = (c0 & 0xffff) | ((c1 & 0xffff) << 16);
+	    }
+	}
+    }
+
+  brush_front = front_color;
+  brush_back = back_color;
+  brush_valid = 1;
+}
+
+/**
+********************************************************************************
+* @function  void _BrushSpans(int x0, int x1, int y, int h)
+* @brief     Span sink of the area fills ,_FillSpans() with the brush.
+*            A patterned span is built in line_buf from brush_words[] (one
+*            word per 2 pixels) and sent as one burst ,the rows of a span
+*            with h > 1 go to one window.
+********************************************************************************
+**/
+static void _BrushSpans(int x0, int x1, int y, int h)
+{
+  const uint32_t *words;
+  int y1 = y + h - 1, xs, w, n, row;
+
+  if(brush == BRUSH_SOLID)
+    {
+      _FillSpans(x0, x1, y, h);
+      return;
+    }
+  if(_ClipRect(&x0, &y, &x1, &y1) != 0)
+    {
+      return;
+    }
+  _UpdateBrush();
+
+  for(xs = x0; xs <= x1; xs += w)    /* line_buf wide pieces */
+    {
+      w = x1 - xs + 1;
+      if(w > LCD_LINE_WORDS * 2)
+	{
+	  w = LCD_LINE_WORDS * 2;
+	}
+      SetXY(xs, y, xs + w - 1, y1);
+      for(row = y; row <= y1; row++)
+	{
+	  words = brush_words[row & 0x07][xs & 0x01];
+	  for(n = 0; n < ((w + 1) >> 1); n++)
+	    {
+	      line_buf[n] = words[(((xs & 0x07) >> 1) + n) & 0x03];
+	    }
+	  lcd_write_pixels((const uint16_t *)line_buf, w);
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _RoundRectSpans(int x0 ,int y0 ,int x1 ,int y1 ,
+*                                 int radius ,span_func_t span)
+* @brief     Span generator for a filled round corner rectangle.
+*            A circle is the round rectangle (x-r ,y-r ,x+r ,y+r ,r).
+*            Every covered row is given to 'span' exactly once :
+*            the corner rows from the top and bottom edges inwards ,
+*            then the full width middle band as a single call.
+*            A corner row at distance dy from the corner centre is
+*            dx pixels wider ,dx is the largest value with
+*            dx*dx + dy*dy <= r*r + r . dx only grows while dy goes down,
+*            so it is found incrementally.
+*            Note: x0 <= x1 , y0 <= y1 , (radius << 1) <= x1 - x0 , y1 - y0
+********************************************************************************
+**/
+static void _RoundRectSpans(int x0 ,int y0 ,int x1 ,int y1 ,
+			    int radius ,span_func_t span)
+{
+  int dy, dx, row, rows;
+  int limit = radius * radius + radius;
+
+  dx = 0;
+  row = 0;    /* first corner row of the current group */
+  rows = 0;   /* rows in the current group ,all of them have the same dx */
+
+  for(dy = radius; dy > 0; dy--)
+    {
+      int next = dx;
+      while((next + 1) * (next + 1) + dy * dy <= limit)
+	{
+	  next++;
+	}
+
+      if(rows != 0 && next != dx)  /* dx changes ,send the group */
+	{
+	  span(x0 + radius - dx, x1 - radius + dx, y0 + row, rows);
+	  span(x0 + radius - dx, x1 - radius + dx, y1 - row - rows + 1, rows);
+	  row += rows;
+	  rows = 0;
+	}
+      dx = next;
+      rows++;
+    }
+
+  if(rows != 0 && dx != radius)
+    {
+      span(x0 + radius - dx, x1 - radius + dx, y0 + row, rows);
+      span(x0 + radius - dx, x1 - radius + dx, y1 - row - rows + 1, rows);
+      row += rows;
+    }
+
+  /* the full width band between the corners (with the last group
+     when it is already full width) */
+  span(x0, x1, y0 + row, (y1 - row) - (y0 + row) + 1);
+}
+
+
+/**
+********************************************************************************
+* @function  void _FillRectangle(int x0 , int y0 , int x1 , int y1)
+* @brief     Draw a filled Rectangle ,cut to the clip rectangle.
+*            Note: x0 <= x1 , y0 <= y1
+********************************************************************************
+**/
+static void _FillRectangle(int x0 , int y0 , int x1 , int y1)
+{
+  if(_ClipRect(&x0, &y0, &x1, &y1) != 0)
+    {
+      return;
+    }
+  if(brush != BRUSH_SOLID)    /* not kept back ,the queues hold one color */
+    {
+      _BrushSpans(x0, x1, y0, y1 - y0 + 1);
+      return;
+    }
+  if(_FrameAdd(FRAME_RECT, x0, y0, x1, y1, 0, front_color) == 0 ||
+     _CullAdd(x0, y0, x1, y1, front_color) == 0)
+    {
+      return;
+    }
+  _FillWindow(x0, y0, x1, y1, front_color);
+}
+
+/**
+********************************************************************************
+* @function  void FillRectangle(unsigned char **args ,int arg_num)
+* @brief     Get parameters and call the _FillRectagnle function.
+********************************************************************************
+**/
+static void FillRectangle(unsigned char **args ,int arg_num)
+{
+  int location[4] ,tmp;
+  unsigned int count;
+  
+  if(arg_num != 4)
+    {
+      return;      
+    }
+
+  for(count = 0 ;count < 4; count++)
+    {
+      location[count] = str_to_int(*(args + count));
+    }
+
+  if(location[0] > location[2])
+    {
+      tmp = location[0];
+      location[0] = location[2];
+      location[2] = tmp;
+    }
+
+  if(location[1] > location[3])
+    {
+      tmp = location[1];
+      location[1] = location[3];
+      location[3] = tmp;
+    }
+
+  _FillRectangle(location[0],location[1],location[2],location[3]);
+}
+
+/**
+********************************************************************************
+* @function  _FillRoundRect(int x0 ,int y0 ,int x1 ,int y1 ,int radius)
+* @brief     Draw a filled round corner rectangle.
+*            All out of the clip rectangle : nothing to do.
+*            Only the shapes all in the clip rectangle can be kept in a frame ,
+*            the others are cut span by span.
+********************************************************************************
+**/
+static void _FillRoundRect(int x0 ,int y0 ,int x1 ,int y1 ,int radius)
+{
+  if(x0 > clip.x1 || x1 < clip.x0 || y0 > clip.y1 || y1 < clip.y0)
+    {
+      return;
+    }
+  if(brush == BRUSH_SOLID && _ClipInside(x0, y0, x1, y1) &&
+     _FrameAdd(FRAME_RRECT, x0, y0, x1, y1, radius, front_color) == 0)
+    {
+      return;
+    }
+  _RoundRectSpans(x0, y0, x1, y1, radius, _BrushSpans);
+}
+
+/**
+********************************************************************************
+* @function  void _Fill_Circle(int x, int y ,int radius)
+* @brief     Draw a filled circle
+********************************************************************************
+**/
+static void _Fill_Circle(int x, int y ,int radius)
+{
+  _FillRoundRect(x - radius, y - radius, x + radius, y + radius, radius);
+}
+
+
+/**
+********************************************************************************
+* @function  void FillCircle(unsigned char **args ,int arg_num)
+* @brief     Get parameters and call the _Fill_Circle function
+********************************************************************************
+**/
+static void FillCircle(unsigned char **args ,int arg_num)
+{
+  int tmp[3]; /* (tmp[0],tmp[1]; r = tmp[2]) */
+
+  if(arg_num != 3)
+    {
+      return;      
+    }
+
+  if(_CoordArgs(args, 3, tmp) != 0)
+    {
+      return;
+    }
+
+  if(tmp[2] < 0)
+    {
+      return ;
+    }
+  _Fill_Circle(tmp[0],tmp[1],tmp[2]);
+}
+
+/**
+********************************************************************************
+* @function  void FillRoundRect(unsigned char **args ,int arg_num)
+* @brief     Get parameters and call the _FillRoundRect function.
+********************************************************************************
+**/
+static void FillRoundRect(unsigned char **args ,int arg_num)
+{
+  int location[5] ,tmp;
+  int delta_x,delta_y;
+  
+  if(arg_num != 5 && arg_num != 4)
+    {
+      return;      
+    }
+
+  if(_CoordArgs(args, arg_num, location) != 0)
+    {
+      return;
+    }
+
+  if(location[0] > location[2])
+    {
+      tmp = location[0];
+      location[0] = location[2];
+      location[2] = tmp;
+    }
+
+  if(location[1] > location[3])
+    {
+      tmp = location[1];
+      location[1] = location[3];
+      location[3] = tmp;
+    }
+  
+  delta_x = location[2] - location[0];
+  delta_y = location[3] - location[1];
+
+  if(arg_num == 4)
+    {
+      location[4] = (delta_x < delta_y)?(delta_x >> 2):(delta_y >> 2);
+    }
+  else if(location[4] < 0 ||
+	  (location[4] << 1) > delta_x || (location[4] << 1) > delta_y)
+    {
+      return;
+    }
+
+  _FillRoundRect(location[0],location[1],location[2],location[3],location[4]);
+}
+
+/**
+********************************************************************************
+* @micro    GRADIENT_V , GRADIENT_H
+* @brief    Directions of AT+gr.
+********************************************************************************
+**/
+#define GRADIENT_V 0    /* the colour changes from top to bottom */
+#define GRADIENT_H 1    /* the colour changes from left to right */
+
+/**
+********************************************************************************
+* @function  void _GradientStart(unsigned int c0 ,unsigned int c1 ,int n ,
+*                                int i ,int32_t *c ,int32_t *dc)
+* @brief     Set up a gradient of 'n' pixels from c0 to c1 (RGB565).
+*            Every channel is stepped on its own in 16.16 fixed point ,c[] is
+*            the colour of the pixel 'i' ,dc[] the step per pixel.
+********************************************************************************
+**/
+static void _GradientStart(unsigned int c0 ,unsigned int c1 ,int n ,int i,
+			   int32_t *c ,int32_t *dc)
+{
+  static const unsigned int shift[3] = {11, 5, 0};
+  static const unsigned int mask[3] = {0x1f, 0x3f, 0x1f};
+  int32_t a, b;
+  unsigned int k;
+
+  for(k = 0; k < 3; k++)
+    {
+      a = (int32_t)((c0 >> shift[k]) & mask[k]);
+      b = (int32_t)((c1 >> shift[k]) & mask[k]);
+      dc[k] = (n > 1)? (((b - a) << 16) / (n - 1)) : 0;
+      c[k] = (a << 16) + dc[k] * i;
+    }
+}
+
+/**
+********************************************************************************
+* @function  unsigned int _GradientNext(int32_t *c ,const int32_t *dc)
+* @brief     Get the current gradient colour and step to the next pixel.
+********************************************************************************
+**/
+static unsigned int _GradientNext(int32_t *c ,const int32_t *dc)
+{
+  unsigned int pixel;
+
+  pixel = ((unsigned int)((c[0] + 0x8000) >> 16) << 11) |
+    ((unsigned int)((c[1] + 0x8000) >> 16) << 5) |
+    (unsigned int)((c[2] + 0x8000) >> 16);
+  c[0] += dc[0];
+  c[1] += dc[1];
+  c[2] += dc[2];
+  return pixel;
+}
+
+/**
+********************************************************************************
+* @function  void _FillGradient(int x0 ,int y0 ,int x1 ,int y1,
+*                               unsigned int c0 ,unsigned int c1 ,
+*                               unsigned int dir)
+* @brief     Fill a rectangle with a linear gradient from c0 to c1.
+*            GRADIENT_V (top to bottom) : every row is one colour ,the rows
+*            of the same colour are one window fill (DMA for large bands).
+*            GRADIENT_H (left to right) : one row is built in line_buf and
+*            sent for every row of one window.
+*            The gradient runs over the whole rectangle ,only the part in the
+*            clip rectangle is drawn.
+*            Note: x0 <= x1 , y0 <= y1
+********************************************************************************
+**/
+static void _FillGradient(int x0 ,int y0 ,int x1 ,int y1,
+			  unsigned int c0 ,unsigned int c1 ,unsigned int dir)
+{
+  uint16_t *row = (uint16_t *)line_buf;
+  int32_t c[3], dc[3];
+  int xs = x0, ys = y0, xe = x1, ye = y1, y, band, w, n;
+  unsigned int color, next;
+
+  if(_ClipRect(&xs, &ys, &xe, &ye) != 0)
+    {
+      return;
+    }
+
+  if(dir == GRADIENT_V)
+    {
+      _GradientStart(c0, c1, y1 - y0 + 1, ys - y0, c, dc);
+      color = _GradientNext(c, dc);
+      band = ys;
+      for(y = ys + 1; y <= ye; y++)
+	{
+	  next = _GradientNext(c, dc);
+	  if(next != color)
+	    {
+	      _FillWindow(xs, band, xe, y - 1, color);
+	      band = y;
+	      color = next;
+	    }
+	}
+      _FillWindow(xs, band, xe, ye, color);
+      return;
+    }
+
+  _GradientStart(c0, c1, x1 - x0 + 1, xs - x0, c, dc);
+  while(xs <= xe)    /* line_buf wide pieces */
+    {
+      w = xe - xs + 1;
+      if(w > LCD_LINE_WORDS * 2)
+	{
+	  w = LCD_LINE_WORDS * 2;
+	}
+      for(n = 0; n < w; n++)
+	{
+	  row[n] = (uint16_t)_GradientNext(c, dc);
+	}
+      SetXY(xs, ys, xs + w - 1, ye);
+      for(y = ys; y <= ye; y++)
+	{
+	  lcd_write_pixels(row, w);
+	}
+      xs += w;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void FillGradient(unsigned char **args ,int arg_num)
+* @brief     AT+gr=x0,y0,x1,y1,c0,c1,dir
+*            Fill a rectangle with a gradient from the colour c0 to c1
+*            (RGB565).
+*            dir --> 0 : vertical ,c0 at the top
+*                    1 : horizontal ,c0 at the left
+********************************************************************************
+**/
+static void FillGradient(unsigned char **args ,int arg_num)
+{
+  int location[4], tmp;
+  unsigned int c0, c1, dir;
+
+  if(arg_num != 7 || _CoordArgs(args, 4, location) != 0)
+    {
+      return;
+    }
+
+  c0 = str_to_uint(*(args + 4)) & 0xffff;
+  c1 = str_to_uint(*(args + 5)) & 0xffff;
+  dir = str_to_uint(*(args + 6));
+  if(dir != GRADIENT_V && dir != GRADIENT_H)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Parameter is not '0' or '1'.\n");
+	}
+      return;
+    }
+
+  if(location[0] > location[2])
+    {
+      tmp = location[0];
+      location[0] = location[2];
+      location[2] = tmp;
+    }
+  if(location[1] > location[3])
+    {
+      tmp = location[1];
+      location[1] = location[3];
+      location[3] = tmp;
+    }
+
+  _FillGradient(location[0], location[1], location[2], location[3],
+		c0, c1, dir);
+}
+
+/**
+********************************************************************************
+* @function  void SetBrush(unsigned char **args ,int arg_num)
+* @brief     AT+pb=n
+*            Select the pattern brush of the area fills.
+*            n --> 0 : solid (front_color)   1 : stipple   2 : hatch
+*                  3 : cross hatch   4 : checkerboard   5 : uploaded (AT+pu)
+********************************************************************************
+**/
+static void SetBrush(unsigned char **args ,int arg_num)
+{
+  unsigned int n;
+
+  if(arg_num != 1)
+    {
+      return;
+    }
+  n = str_to_uint(*args);
+  if(n > BRUSH_USER)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Brush is 0 ~ %d.\n", BRUSH_USER);
+	}
+      return;
+    }
+  brush = (unsigned char)n;
+  brush_valid = 0;
+}
+
+/**
+********************************************************************************
+* @function  void UploadBrush(unsigned char **args ,int arg_num)
+* @brief     AT+pu=b0,b1,b2,b3,b4,b5,b6,b7
+*            Upload an 8 x 8 pattern (b0 is the top row ,bit 7 the left
+*            pixel) and select it.
+********************************************************************************
+**/
+static void UploadBrush(unsigned char **args ,int arg_num)
+{
+  unsigned int row;
+
+  if(arg_num != 8)
+    {
+      return;
+    }
+  for(row = 0; row < 8; row++)
+    {
+      brush_user[row] = (unsigned char)str_to_uint(*(args + row));
+    }
+  brush = BRUSH_USER;
+  brush_valid = 0;
+}
+
+/**
+********************************************************************************
+* @function  void ReadPixels_uart1(unsigned char **args ,int arg_num)
+* @brief     AT+rp=x,y or AT+rp=x0,y0,x1,y1
+*            Read a pixel or an area back from the GRAM and print the RGB565
+*            values (hex) to usart1 ,one line per row.
+*            The area is cut to the screen ,not to the clip rectangle.
+********************************************************************************
+**/
+static void ReadPixels_uart1(unsigned char **args ,int arg_num)
+{
+  uint16_t *row = (uint16_t *)line_buf;
+  int location[4], tmp, xs, y, w, n;
+  unsigned int count;
+
+  if(arg_num != 2 && arg_num != 4)
+    {
+      return;
+    }
+
+  for(count = 0; count < (unsigned int)arg_num; count++)
+    {
+      location[count] = str_to_int(*(args + count));
+    }
+  if(arg_num == 2)
+    {
+      location[2] = location[0];
+      location[3] = location[1];
+    }
+  if(location[0] > location[2])
+    {
+      tmp = location[0];
+      location[0] = location[2];
+      location[2] = tmp;
+    }
+  if(location[1] > location[3])
+    {
+      tmp = location[1];
+      location[1] = location[3];
+      location[3] = tmp;
+    }
+  if(location[0] < 0)
+    {
+      location[0] = 0;
+    }
+  if(location[1] < 0)
+    {
+      location[1] = 0;
+    }
+  if(location[2] > (int)display_x - 1)
+    {
+      location[2] = (int)display_x - 1;
+    }
+  if(location[3] > (int)display_y - 1)
+    {
+      location[3] = (int)display_y - 1;
+    }
+  if(location[0] > location[2] || location[1] > location[3])
+    {
+      return;
+    }
+
+  for(y = location[1]; y <= location[3]; y++)
+    {
+      for(xs = location[0]; xs <= location[2]; xs += w)
+	{
+	  w = location[2] - xs + 1;
+	  if(w > LCD_LINE_WORDS * 2)
+	    {
+	      w = LCD_LINE_WORDS * 2;
+	    }
+	  SetXY(xs, y, xs + w - 1, y);
+	  lcd_read_pixels(row, w);
+	  for(n = 0; n < w; n++)
+	    {
+	      usart1.printf(&usart1,"%04x%c",row[n],
+			    (xs + n == location[2])? '\n' : ',');
+	    }
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _CopyRect(int x0 ,int y0 ,int x1 ,int y1 ,int dx ,int dy)
+* @brief     Copy the area x0 ,y0 ~ x1 ,y1 to dx ,dy (top left).
+*            The source is cut to the screen and the destination to the clip
+*            rectangle. Each row piece is read back to line_buf and written
+*            to its new place ,in the order that keeps overlapping areas
+*            right : from the bottom when moving down ,from the right when
+*            moving right.
+*            Note: x0 <= x1 , y0 <= y1
+********************************************************************************
+**/
+static void _CopyRect(int x0 ,int y0 ,int x1 ,int y1 ,int dx ,int dy)
+{
+  uint16_t *row = (uint16_t *)line_buf;
+  int ox, oy, x, y, w, step;
+
+  /* the source in the screen */
+  if(x0 < 0)
+    {
+      dx -= x0;
+      x0 = 0;
+    }
+  if(y0 < 0)
+    {
+      dy -= y0;
+      y0 = 0;
+    }
+  if(x1 > (int)display_x - 1)
+    {
+      x1 = (int)display_x - 1;
+    }
+  if(y1 > (int)display_y - 1)
+    {
+      y1 = (int)display_y - 1;
+    }
+  if(x0 > x1 || y0 > y1)
+    {
+      return;
+    }
+
+  /* the destination in the clip rectangle ,the source cut the same */
+  ox = dx - x0;
+  oy = dy - y0;
+  x0 += ox;
+  y0 += oy;
+  x1 += ox;
+  y1 += oy;
+  if(_ClipRect(&x0, &y0, &x1, &y1) != 0)
+    {
+      return;
+    }
+  x0 -= ox;
+  y0 -= oy;
+  x1 -= ox;
+  y1 -= oy;
+
+  step = (oy > 0)? -1 : 1;
+  for(y = (oy > 0)? y1 : y0; y >= y0 && y <= y1; y += step)
+    {
+      x = (ox > 0)? x1 + 1 : x0;
+      while((ox > 0)? (x > x0) : (x <= x1))
+	{
+	  w = (ox > 0)? x - x0 : x1 - x + 1;
+	  if(w > LCD_LINE_WORDS * 2)
+	    {
+	      w = LCD_LINE_WORDS * 2;
+	    }
+	  if(ox > 0)
+	    {
+	      x -= w;
+	    }
+	  SetXY(x, y, x + w - 1, y);
+	  lcd_read_pixels(row, w);
+	  SetSpan(x + ox, x + ox + w - 1, y + oy);
+	  lcd_write_pixels(row, w);
+	  if(ox <= 0)
+	    {
+	      x += w;
+	    }
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void CopyRect(unsigned char **args ,int arg_num)
+* @brief     AT+cy=x0,y0,x1,y1,dx,dy
+*            Copy the area x0 ,y0 ~ x1 ,y1 of the screen to dx ,dy (the new
+*            top left corner) ,the areas may overlap.
+********************************************************************************
+**/
+static void CopyRect(unsigned char **args ,int arg_num)
+{
+  int location[6], tmp;
+
+  if(arg_num != 6)
+    {
+      return;
+    }
+
+  if(_CoordArgs(args, 6, location) != 0)
+    {
+      return;
+    }
+  if(location[0] > location[2])
+    {
+      tmp = location[0];
+      location[0] = location[2];
+      location[2] = tmp;
+    }
+  if(location[1] > location[3])
+    {
+      tmp = location[1];
+      location[1] = location[3];
+      location[3] = tmp;
+    }
+
+  _CopyRect(location[0], location[1], location[2], location[3],
+	    location[4], location[5]);
+}
+
+/**
+********************************************************************************
+* @variable poly_edge
+* @brief    Edge table of the polygon filler.
+*           The vertices are 28.4 fixed point (POLY_FRAC) ,the pixel (x ,y)
+*           covers x ~ x + 1 ,y ~ y + 1 .
+*           A pixel is filled when its centre is inside the polygon ,so an
+*           edge from y0 to y1 (y0 < y1) crosses the scanlines whose centre
+*           is in y0 ~ y1 (y1 not included) and two polygons sharing an
+*           edge never fill a pixel twice.
+*           Edges crossing no scanline centre are not in the table.
+*           ymin , ymax --> the first scanline and the one after the last
+*           x           --> 16.16 fixed point crossing of the current
+*                           scanline's pixel centres
+*           dx          --> x step per scanline (16.16)
+*           dir         --> 1 : the edge goes down ,-1 : it goes up
+*                           (non-zero winding)
+********************************************************************************
+**/
+#define POLY_MAX_VERTEX 16
+#define POLY_MAX_COORD  CMD_MAX_COORD  /* |x| ,|y| limit ,keeps x in 16.16 */
+#define POLY_FRAC       4       /* fraction bits of the vertices */
+
+#define POLY_EVEN_ODD 0
+#define POLY_NON_ZERO 1
+
+struct _poly_edge
+{
+  int ymin;
+  int ymax;
+  int32_t x;
+  int32_t dx;
+  int dir;
+};
+
+static struct _poly_edge poly_edge[POLY_MAX_VERTEX];
+
+/**
+********************************************************************************
+* @function  void _FillPolygon(const int *xy ,unsigned int n ,unsigned int rule,
+*                              span_func_t span)
+* @brief     Fill a polygon of 'n' vertices (28.4 x ,y pairs in 'xy') with
+*            front_color or the brush.
+*            Integer active edge table : the edges are sorted by their first
+*            scanline and join the active list on it ,the active list is
+*            kept sorted by x (insertion sort ,it hardly changes between
+*            scanlines). Every crossing pair of a scanline is one span for
+*            'span' (_FillSpans() or _BrushSpans()) ,which clips it and
+*            sends it as one burst.
+*            rule --> POLY_EVEN_ODD : a pixel is inside after an odd number
+*                     of crossings
+*                     POLY_NON_ZERO : a pixel is inside when the edge
+*                     directions up to it do not sum to 0
+********************************************************************************
+**/
+static void _FillPolygon(const int *xy ,unsigned int n ,unsigned int rule,
+			 span_func_t span)
+{
+  struct _poly_edge tmp;
+  unsigned char active[POLY_MAX_VERTEX];
+  unsigned int edges, next, count, i, j;
+  int x0, y0, x1, y1, y, ystart, yend, winding, xs, xe, t;
+
+  /* build the edge table ,sorted by ymin */
+  edges = 0;
+  for(i = 0; i < n; i++)
+    {
+      x0 = xy[i << 1];
+      y0 = xy[(i << 1) + 1];
+      x1 = xy[((i + 1) % n) << 1];
+      y1 = xy[(((i + 1) % n) << 1) + 1];
+      tmp.dir = 1;
+      if(y0 > y1)
+	{
+	  t = x0; x0 = x1; x1 = t;
+	  t = y0; y0 = y1; y1 = t;
+	  tmp.dir = -1;
+	}
+      /* the first scanline with its centre at or below y0 */
+      tmp.ymin = (y0 + (1 << (POLY_FRAC - 1)) - 1) >> POLY_FRAC;
+      tmp.ymax = (y1 + (1 << (POLY_FRAC - 1)) - 1) >> POLY_FRAC;
+      if(tmp.ymin >= tmp.ymax)
+	{
+	  continue;
+	}
+      tmp.dx = (int32_t)(((int64_t)(x1 - x0) << 16) / (y1 - y0));
+      tmp.x = ((int32_t)x0 << (16 - POLY_FRAC)) +
+	(int32_t)(((int64_t)tmp.dx *
+		   ((tmp.ymin << POLY_FRAC) + (1 << (POLY_FRAC - 1)) - y0))
+		  >> POLY_FRAC);
+
+      for(j = edges; j > 0 && poly_edge[j - 1].ymin > tmp.ymin; j--)
+	{
+	  poly_edge[j] = poly_edge[j - 1];
+	}
+      poly_edge[j] = tmp;
+      edges++;
+    }
+  if(edges == 0)
+    {
+      return;
+    }
+
+  /* only the scanlines in the clip rectangle are walked */
+  ystart = poly_edge[0].ymin;
+  yend = poly_edge[0].ymax;
+  for(i = 1; i < edges; i++)
+    {
+      if(poly_edge[i].ymax > yend)
+	{
+	  yend = poly_edge[i].ymax;
+	}
+    }
+  if(ystart < clip.y0)
+    {
+      ystart = clip.y0;
+    }
+  if(yend > clip.y1 + 1)
+    {
+      yend = clip.y1 + 1;
+    }
+
+  next = 0;
+  count = 0;
+  for(y = ystart; y < yend; y++)
+    {
+      /* drop the finished edges ,step the others to this scanline */
+      for(i = 0, j = 0; i < count; i++)
+	{
+	  if(poly_edge[active[i]].ymax > y)
+	    {
+	      active[j++] = active[i];
+	      poly_edge[active[i]].x += poly_edge[active[i]].dx;
+	    }
+	}
+      count = j;
+
+      /* new edges ,an edge starting above the clip is moved to 'y' */
+      while(next < edges && poly_edge[next].ymin <= y)
+	{
+	  if(poly_edge[next].ymax > y)
+	    {
+	      poly_edge[next].x += (int32_t)((int64_t)poly_edge[next].dx *
+					     (y - poly_edge[next].ymin));
+	      active[count++] = (unsigned char)next;
+	    }
+	  next++;
+	}
+
+      /* keep the active list sorted by x */
+      for(i = 1; i < count; i++)
+	{
+	  unsigned char e = active[i];
+	  for(j = i; j > 0 && poly_edge[active[j - 1]].x > poly_edge[e].x; j--)
+	    {
+	      active[j] = active[j - 1];
+	    }
+	  active[j] = e;
+	}
+
+      /* pixel x is filled when x + 0.5 is in [left ,right) */
+      winding = 0;
+      for(i = 0; i + 1 < count; i++)
+	{
+	  if(rule == POLY_NON_ZERO)
+	    {
+	      winding += poly_edge[active[i]].dir;
+	      if(winding == 0)
+		{
+		  continue;
+		}
+	    }
+	  else if((i & 1) != 0)
+	    {
+	      continue;
+	    }
+	  xs = (poly_edge[active[i]].x + 0x7fff) >> 16;
+	  xe = ((poly_edge[active[i + 1]].x + 0x7fff) >> 16) - 1;
+	  if(xs <= xe)
+	    {
+	      span(xs, xe, y, 1);
+	    }
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void FillPolygon(unsigned char **args ,int arg_num)
+* @brief     AT+fp=rule,x0,y0,x1,y1,x2,y2[,...]
+*            Fill a polygon of 3 ~ POLY_MAX_VERTEX vertices ,the last vertex
+*            is joined to the first one.
+*            rule --> 0 : even-odd ,1 : non-zero winding
+*            The vertices may be out of the screen ,the polygon is clipped.
+********************************************************************************
+**/
+static void FillPolygon(unsigned char **args ,int arg_num)
+{
+  int xy[POLY_MAX_VERTEX * 2];
+  unsigned int count, rule;
+
+  if(arg_num < 7 || (arg_num & 1) == 0 ||
+     arg_num > POLY_MAX_VERTEX * 2 + 1)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Polygon needs 3 ~ %d vertices.\n",
+			POLY_MAX_VERTEX);
+	}
+      return;
+    }
+
+  rule = str_to_uint(*args);
+  if(rule != POLY_EVEN_ODD && rule != POLY_NON_ZERO)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Parameter is not '0' or '1'.\n");
+	}
+      return;
+    }
+
+  for(count = 0; count < (unsigned int)arg_num - 1; count++)
+    {
+      xy[count] = str_to_int(*(args + count + 1));
+      if(xy[count] > POLY_MAX_COORD || xy[count] < -POLY_MAX_COORD)
+	{
+	  return;
+	}
+      xy[count] <<= POLY_FRAC;
+    }
+
+  _FillPolygon(xy, (arg_num - 1) >> 1, rule, _BrushSpans);
+}
+
+/**
+********************************************************************************
+* @struct   _tri_vertex , _tri_edge
+* @brief    Triangle vertex and edge walker for the Gouraud filler.
+*           The colour is kept as 3 channels (R 0~31 ,G 0~63 ,B 0~31) in
+*           16.16 fixed point.
+*           An edge walker holds x and the colour at the pixel centres of
+*           the current scanline ,and their steps per scanline.
+********************************************************************************
+**/
+struct _tri_vertex
+{
+  int x;
+  int y;
+  int32_t c[3];
+};
+
+struct _tri_edge
+{
+  int32_t x;
+  int32_t dx;
+  int32_t c[3];
+  int32_t dc[3];
+};
+
+/**
+********************************************************************************
+* @function  void _TriEdgeStart(struct _tri_edge *e ,const struct _tri_vertex *a,
+*                              const struct _tri_vertex *b ,int y)
+* @brief     Set the edge walker of the edge from 'a' to 'b' to the scanline
+*            'y' (at y + 0.5).
+*            Note: a->y <= y < b->y
+********************************************************************************
+**/
+static void _TriEdgeStart(struct _tri_edge *e ,const struct _tri_vertex *a,
+			  const struct _tri_vertex *b ,int y)
+{
+  int h = b->y - a->y;
+  int32_t t;    /* (y + 0.5 - a->y) / h ,16.16 */
+  unsigned int k;
+
+  t = (int32_t)((((int64_t)(y - a->y) << 1) + 1) << 15) / h;
+  e->dx = (int32_t)(((int64_t)(b->x - a->x) << 16) / h);
+  e->x = ((int32_t)a->x << 16) + (b->x - a->x) * t;
+  for(k = 0; k < 3; k++)
+    {
+      e->dc[k] = (b->c[k] - a->c[k]) / h;
+      e->c[k] = a->c[k] + (int32_t)(((int64_t)(b->c[k] - a->c[k]) * t) >> 16);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _TriEdgeStep(struct _tri_edge *e)
+* @brief     Move the edge walker to the next scanline.
+********************************************************************************
+**/
+static void _TriEdgeStep(struct _tri_edge *e)
+{
+  e->x += e->dx;
+  e->c[0] += e->dc[0];
+  e->c[1] += e->dc[1];
+  e->c[2] += e->dc[2];
+}
+
+/**
+********************************************************************************
+* @function  void _TriSpan(int y ,const struct _tri_edge *a,
+*                          const struct _tri_edge *b)
+* @brief     Send the scanline 'y' between two edge walkers.
+*            The colour is stepped across the span in fixed point ,the
+*            pixels are built in line_buf and sent as one burst.
+*            The span is cut to the clip rectangle.
+********************************************************************************
+**/
+static void _TriSpan(int y ,const struct _tri_edge *a,
+		     const struct _tri_edge *b)
+{
+  static const int32_t max[3] = {31, 63, 31};
+  const struct _tri_edge *l = a, *r = b;
+  uint16_t *dst = (uint16_t *)line_buf;
+  int32_t c[3], dcdx[3], v;
+  int xs, xe, x;
+  unsigned int k, pixel;
+
+  if(a->x > b->x)
+    {
+      l = b;
+      r = a;
+    }
+
+  /* pixel x is filled when x + 0.5 is in [l->x ,r->x) */
+  xs = (l->x + 0x7fff) >> 16;
+  xe = ((r->x + 0x7fff) >> 16) - 1;
+  if(xs < clip.x0)
+    {
+      xs = clip.x0;
+    }
+  if(xe > clip.x1)
+    {
+      xe = clip.x1;
+    }
+  if(xs > xe)
+    {
+      return;
+    }
+
+  for(k = 0; k < 3; k++)
+    {
+      dcdx[k] = (int32_t)(((int64_t)(r->c[k] - l->c[k]) << 16) /
+			  (r->x - l->x));
+      c[k] = l->c[k] + (int32_t)(((int64_t)dcdx[k] *
+				  (((int32_t)xs << 16) + 0x8000 - l->x)) >> 16);
+    }
+
+  for(x = xs; x <= xe; x++)
+    {
+      pixel = 0;
+      for(k = 0; k < 3; k++)
+	{
+	  v = (c[k] + 0x8000) >> 16;
+	  if(v < 0)
+	    {
+	      v = 0;
+	    }
+	  else if(v > max[k])
+	    {
+	      v = max[k];
+	    }
+	  pixel = (pixel << ((k == 1)? 6 : 5)) | (unsigned int)v;
+	  c[k] += dcdx[k];
+	}
+      *dst++ = (uint16_t)pixel;
+    }
+
+  SetSpan(xs, xe, y);
+  lcd_write_pixels((const uint16_t *)line_buf, xe - xs + 1);
+}
+
+/**
+********************************************************************************
+* @function  void _FillTriangle_G(struct _tri_vertex *v)
+* @brief     Fill the triangle v[0] ,v[1] ,v[2] with the vertex colours
+*            interpolated (Gouraud).
+*            Edge walking : the vertices are sorted by y ,every scanline lies
+*            between the long edge v[0] - v[2] and one of the short edges.
+*            The covered pixels are the same as _FillPolygon() fills.
+********************************************************************************
+**/
+static void _FillTriangle_G(struct _tri_vertex *v)
+{
+  struct _tri_vertex tmp;
+  struct _tri_edge long_edge, short_edge;
+  unsigned int i, j;
+  int y, ystart, yend;
+
+  for(i = 1; i < 3; i++)    /* sort by y */
+    {
+      tmp = v[i];
+      for(j = i; j > 0 && v[j - 1].y > tmp.y; j--)
+	{
+	  v[j] = v[j - 1];
+	}
+      v[j] = tmp;
+    }
+
+  ystart = (v[0].y > clip.y0)? v[0].y : clip.y0;
+  yend = (v[2].y < clip.y1 + 1)? v[2].y : clip.y1 + 1;
+  if(ystart >= yend)
+    {
+      return;
+    }
+
+  _TriEdgeStart(&long_edge, &v[0], &v[2], ystart);
+  if(ystart < v[1].y)
+    {
+      _TriEdgeStart(&short_edge, &v[0], &v[1], ystart);
+    }
+  for(y = ystart; y < yend; y++)
+    {
+      if(y == v[1].y || (y == ystart && y > v[1].y))
+	{
+	  _TriEdgeStart(&short_edge, &v[1], &v[2], y);
+	}
+      _TriSpan(y, &long_edge, &short_edge);
+      _TriEdgeStep(&long_edge);
+      _TriEdgeStep(&short_edge);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void FillTriangle(unsigned char **args ,int arg_num)
+* @brief     AT+ft=x0,y0,x1,y1,x2,y2[,c0,c1,c2]
+*            6 parameters : a triangle filled with front_color.
+*            9 parameters : c0 ,c1 ,c2 are the RGB565 colours of the
+*                           vertices ,they are blended over the triangle.
+*            The vertices may be out of the screen ,the triangle is clipped.
+********************************************************************************
+**/
+static void FillTriangle(unsigned char **args ,int arg_num)
+{
+  struct _tri_vertex v[3];
+  int xy[6];
+  unsigned int count, color;
+
+  if(arg_num != 6 && arg_num != 9)
+    {
+      return;
+    }
+
+  for(count = 0; count < 6; count++)
+    {
+      xy[count] = str_to_int(*(args + count));
+      if(xy[count] > POLY_MAX_COORD || xy[count] < -POLY_MAX_COORD)
+	{
+	  return;
+	}
+    }
+
+  if(arg_num == 6)
+    {
+      for(count = 0; count < 6; count++)
+	{
+	  xy[count] <<= POLY_FRAC;
+	}
+      _FillPolygon(xy, 3, POLY_EVEN_ODD, _BrushSpans);
+      return;
+    }
+
+  for(count = 0; count < 3; count++)
+    {
+      color = str_to_uint(*(args + 6 + count));
+      v[count].x = xy[count << 1];
+      v[count].y = xy[(count << 1) + 1];
+      v[count].c[0] = (int32_t)((color >> 11) & 0x1f) << 16;
+      v[count].c[1] = (int32_t)((color >> 5) & 0x3f) << 16;
+      v[count].c[2] = (int32_t)(color & 0x1f) << 16;
+    }
+  _FillTriangle_G(v);
+}
+
+/**
+********************************************************************************
+* @typedef   row_func_t
+* @brief     Gets the quadrant outline of a curve row by row : the pixels
+*            xs ~ xe (xs <= xe ,both >= 0) of row y (y >= 0) ,relative to
+*            the centre. Rows come from y = ry down to y = 0 ,once each.
+********************************************************************************
+**/
+typedef void (*row_func_t)(int xs, int xe, int y);
+
+static int ell_x, ell_y;    /* centre of the ellipse being drawn */
+
+/**
+********************************************************************************
+* @function  void _EllipseRows(int rx ,int ry ,row_func_t row)
+* @brief     Midpoint ellipse ,integer only.
+*            Region 1 (slope > -1) steps x and region 2 steps y ,the
+*            decision values are kept 4 times bigger so they stay integer.
+*            The points of one row are joined into one run for 'row'.
+*            Note: rx > 0 , ry > 0
+********************************************************************************
+**/
+static void _EllipseRows(int rx ,int ry ,row_func_t row)
+{
+  int64_t rx2 = (int64_t)rx * rx, ry2 = (int64_t)ry * ry;
+  int64_t dx, dy, d;
+  int x = 0, y = ry, xs = 0;
+
+  /* region 1 */
+  dx = 0;
+  dy = 2 * rx2 * y;
+  d = 4 * ry2 - 4 * rx2 * ry + rx2;
+  while(dx < dy)
+    {
+      x++;
+      dx += 2 * ry2;
+      if(d < 0)
+	{
+	  d += 4 * (dx + ry2);
+	}
+      else    /* the next point is on the next row */
+	{
+	  row(xs, x - 1, y);
+	  y--;
+	  dy -= 2 * rx2;
+	  d += 4 * (dx - dy + ry2);
+	  xs = x;
+	}
+    }
+
+  /* region 2 */
+  d = ry2 * (2 * x + 1) * (2 * x + 1) + 4 * rx2 * (y - 1) * (y - 1)
+    - 4 * rx2 * ry2;
+  while(y > 0)
+    {
+      if(d > 0)
+	{
+	  row(xs, x, y);
+	  y--;
+	  dy -= 2 * rx2;
+	  d += 4 * (rx2 - dy);
+	}
+      else
+	{
+	  x++;
+	  dx += 2 * ry2;
+	  row(xs, x - 1, y);
+	  y--;
+	  dy -= 2 * rx2;
+	  d += 4 * (dx - dy + rx2);
+	}
+      xs = x;
+    }
+  row(xs, rx, 0);
+}
+
+/**
+********************************************************************************
+* @function  void _EllipseOutlineRow(int xs ,int xe ,int y)
+* @brief     row_func_t that draws a run of the outline in the 4 quadrants.
+********************************************************************************
+**/
+static void _EllipseOutlineRow(int xs ,int xe ,int y)
+{
+  if(xs == 0)    /* the left and right runs meet at the centre column */
+    {
+      _FillSpans(ell_x - xe, ell_x + xe, ell_y - y, 1);
+      if(y != 0)
+	{
+	  _FillSpans(ell_x - xe, ell_x + xe, ell_y + y, 1);
+	}
+      return;
+    }
+  _FillSpans(ell_x + xs, ell_x + xe, ell_y - y, 1);
+  _FillSpans(ell_x - xe, ell_x - xs, ell_y - y, 1);
+  if(y != 0)
+    {
+      _FillSpans(ell_x + xs, ell_x + xe, ell_y + y, 1);
+      _FillSpans(ell_x - xe, ell_x - xs, ell_y + y, 1);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _EllipseFillRow(int xs ,int xe ,int y)
+* @brief     row_func_t that fills the rows y and -y up to the outline.
+********************************************************************************
+**/
+static void _EllipseFillRow(int xs ,int xe ,int y)
+{
+  xs = xe;    /* only the outer end of the run is needed */
+  _BrushSpans(ell_x - xs, ell_x + xe, ell_y - y, 1);
+  if(y != 0)
+    {
+      _BrushSpans(ell_x - xs, ell_x + xe, ell_y + y, 1);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _Ellipse(int x ,int y ,int rx ,int ry ,row_func_t row)
+* @brief     Draw (row = _EllipseOutlineRow) or fill (row = _EllipseFillRow)
+*            an ellipse.
+*            An ellipse all out of the clip rectangle is skipped ,a flat one
+*            (rx or ry is 0) is a line.
+********************************************************************************
+**/
+static void _Ellipse(int x ,int y ,int rx ,int ry ,row_func_t row)
+{
+  if(x + rx < clip.x0 || x - rx > clip.x1 ||
+     y + ry < clip.y0 || y - ry > clip.y1)
+    {
+      return;
+    }
+  if(rx == 0 || ry == 0)
+    {
+      _FillSpans(x - rx, x + rx, y - ry, (ry << 1) + 1);
+      return;
+    }
+  ell_x = x;
+  ell_y = y;
+  _EllipseRows(rx, ry, row);
+}
+
+/**
+********************************************************************************
+* @function  int _EllipseArgs(unsigned char **args ,int arg_num ,int *v)
+* @brief     Get x ,y ,rx ,ry of an ellipse command.
+* @return    0  --> succeed
+*            -1 --> wrong parameters
+********************************************************************************
+**/
+static int _EllipseArgs(unsigned char **args ,int arg_num ,int *v)
+{
+  unsigned int count;
+
+  if(arg_num != 4)
+    {
+      return -1;
+    }
+  for(count = 0; count < 4; count++)
+    {
+      v[count] = str_to_int(*(args + count));
+      if(v[count] > POLY_MAX_COORD || v[count] < -POLY_MAX_COORD)
+	{
+	  return -1;
+	}
+    }
+  return (v[2] < 0 || v[3] < 0)? -1 : 0;
+}
+
+/**
+********************************************************************************
+* @function  void DrawEllipse(unsigned char **args ,int arg_num)
+* @brief     AT+de=x,y,rx,ry
+*            Draw an ellipse ,centre (x ,y) ,radii rx (horizontal) and ry.
+********************************************************************************
+**/
+static void DrawEllipse(unsigned char **args ,int arg_num)
+{
+  int v[4];
+
+  if(_EllipseArgs(args, arg_num, v) == 0)
+    {
+      _Ellipse(v[0], v[1], v[2], v[3], _EllipseOutlineRow);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void FillEllipse(unsigned char **args ,int arg_num)
+* @brief     AT+fe=x,y,rx,ry
+*            Fill an ellipse ,each row is one span.
+********************************************************************************
+**/
+static void FillEllipse(unsigned char **args ,int arg_num)
+{
+  int v[4];
+
+  if(_EllipseArgs(args, arg_num, v) == 0)
+    {
+      _Ellipse(v[0], v[1], v[2], v[3], _EllipseFillRow);
+    }
+}
+
+/**
+********************************************************************************
+* @variable sin_q14
+* @brief    sin(0 ~ 90 degrees) * 16384 ,for the arc and pie limits.
+********************************************************************************
+**/
+static const uint16_t sin_q14[91] =
+  {
+	0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+  };
+
+/**
+********************************************************************************
+* @struct   _sector
+* @brief    Angle limits of an arc or a pie ,as Q14 unit vectors (y up).
+*           A point p (relative to the centre ,y up) is in the sector when
+*           it is on the left of 'start' and on the right of 'end' :
+*             cross(start ,p) >= 0 and cross(p ,end) >= 0
+*           A sector wider than 180 degrees is the screen without the
+*           narrower sector from 'end' to 'start' ,'outside' is then 1.
+*           whole --> 1 : 360 degrees ,no limit
+********************************************************************************
+**/
+struct _sector
+{
+  int start_x;
+  int start_y;
+  int end_x;
+  int end_y;
+  unsigned char outside;
+  unsigned char whole;
+};
+
+/**
+********************************************************************************
+* @function  int _SinQ14(int a)
+* @brief     sin(a / 16 degrees) * 16384 ,a = 0 ~ 1440 (0 ~ 90 degrees).
+*            Linear between the whole degrees of sin_q14[].
+********************************************************************************
+**/
+static int _SinQ14(int a)
+{
+  int i = a >> 4, f = a & 0x0f;
+
+  if(f == 0)
+    {
+      return sin_q14[i];
+    }
+  return sin_q14[i] + (((sin_q14[i + 1] - sin_q14[i]) * f) >> 4);
+}
+
+/**
+********************************************************************************
+* @function  void _AngleVector(int angle ,int *x ,int *y)
+* @brief     Q14 unit vector of 'angle' 1/16 degrees (0 ~ 5759) ,y up.
+********************************************************************************
+**/
+static void _AngleVector(int angle ,int *x ,int *y)
+{
+  int q = angle / 1440, a = angle % 1440;
+  int s = _SinQ14(a), c = _SinQ14(1440 - a);
+
+  switch(q)
+    {
+    case 0:
+      *x = c;  *y = s;
+      break;
+    case 1:
+      *x = -s; *y = c;
+      break;
+    case 2:
+      *x = -c; *y = -s;
+      break;
+    default:
+      *x = s;  *y = -c;
+      break;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _SetSector(struct _sector *sec ,int start ,int end)
+* @brief     Set the sector from 'start' to 'end' degrees ,counter-clockwise.
+*            0 is 3 o'clock ,90 is 12 o'clock. 'end' - 'start' of 360 or
+*            more is the whole circle.
+********************************************************************************
+**/
+static void _SetSector(struct _sector *sec ,int start ,int end)
+{
+  int sweep = end - start;
+
+  sec->whole = (sweep >= 360 || sweep <= -360)? 1 : 0;
+  start = ((start % 360) + 360) % 360;
+  end = ((end % 360) + 360) % 360;
+  sweep = ((end - start) + 360) % 360;
+  if(sweep <= 180)
+    {
+      _AngleVector(start << 4, &sec->start_x, &sec->start_y);
+      _AngleVector(end << 4, &sec->end_x, &sec->end_y);
+      sec->outside = 0;
+    }
+  else    /* the narrower sector from 'end' to 'start' is cut out */
+    {
+      _AngleVector(end << 4, &sec->start_x, &sec->start_y);
+      _AngleVector(start << 4, &sec->end_x, &sec->end_y);
+      sec->outside = 1;
+    }
+}
+
+/**
+********************************************************************************
+* @function  int _InSector(const struct _sector *sec ,int x ,int y)
+* @brief     Test a pixel (relative to the centre ,screen y down).
+* @return    1 --> in the sector
+*            0 --> out of it
+********************************************************************************
+**/
+static int _InSector(const struct _sector *sec ,int x ,int y)
+{
+  int in;
+
+  if(sec->whole != 0)
+    {
+      return 1;
+    }
+  y = -y;
+  if(sec->outside == 0)
+    {
+      return (sec->start_x * y - sec->start_y * x >= 0 &&
+	      x * sec->end_y - y * sec->end_x >= 0);
+    }
+  in = (sec->start_x * y - sec->start_y * x > 0 &&
+	x * sec->end_y - y * sec->end_x > 0);
+  return !in;
+}
+
+/**
+********************************************************************************
+* @function  void _HalfPlane(int a ,int c ,int *lo ,int *hi)
+* @brief     Cut the row interval lo ~ hi to the x with a * x + c >= 0.
+*            The division is rounded inwards ,so the interval holds exactly
+*            the pixels that pass the test.
+********************************************************************************
+**/
+static void _HalfPlane(int a ,int c ,int *lo ,int *hi)
+{
+  int b;
+
+  if(a == 0)
+    {
+      if(c < 0)
+	{
+	  *lo = 1;
+	  *hi = 0;
+	}
+      return;
+    }
+  if(a > 0)    /* x >= ceil(-c / a) */
+    {
+      b = (-c >= 0)? (-c + a - 1) / a : -(c / a);
+      if(b > *lo)
+	{
+	  *lo = b;
+	}
+    }
+  else         /* x <= floor(c / -a) */
+    {
+      a = -a;
+      b = (c >= 0)? c / a : -((-c + a - 1) / a);
+      if(b < *hi)
+	{
+	  *hi = b;
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _SectorRow(const struct _sector *sec ,int x ,int y ,
+*                            int dy ,int w)
+* @brief     Fill the pixels -w ~ w of the row dy (relative to the centre
+*            (x ,y) ,screen y down) that are in the sector ,at most 2 spans.
+********************************************************************************
+**/
+static void _SectorRow(const struct _sector *sec ,int x ,int y ,int dy ,int w)
+{
+  int lo, hi, py = -dy;
+
+  if(sec->whole != 0)
+    {
+      _BrushSpans(x - w, x + w, y + dy, 1);
+      return;
+    }
+
+  lo = -w;
+  hi = w;
+  if(sec->outside == 0)
+    {
+      _HalfPlane(-sec->start_y, sec->start_x * py, &lo, &hi);
+      _HalfPlane(sec->end_y, -sec->end_x * py, &lo, &hi);
+      if(lo <= hi)
+	{
+	  _BrushSpans(x + lo, x + hi, y + dy, 1);
+	}
+      return;
+    }
+
+  /* the pixels strictly in the cut out sector are left */
+  _HalfPlane(-sec->start_y, sec->start_x * py - 1, &lo, &hi);
+  _HalfPlane(sec->end_y, -sec->end_x * py - 1, &lo, &hi);
+  if(lo > hi)
+    {
+      _BrushSpans(x - w, x + w, y + dy, 1);
+      return;
+    }
+  if(lo > -w)
+    {
+      _BrushSpans(x - w, x + lo - 1, y + dy, 1);
+    }
+  if(hi < w)
+    {
+      _BrushSpans(x + hi + 1, x + w, y + dy, 1);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _FillPie(int x ,int y ,int radius ,const struct _sector *sec)
+* @brief     Fill a pie slice.
+*            Every row of the circle (the same rows as _RoundRectSpans()) is
+*            cut to the sector by its two edge half-planes ,so each row is
+*            one or two exact spans.
+********************************************************************************
+**/
+static void _FillPie(int x ,int y ,int radius ,const struct _sector *sec)
+{
+  int dy, dx = 0;
+  int limit = radius * radius + radius;
+
+  for(dy = radius; dy >= 0; dy--)
+    {
+      while((dx + 1) * (dx + 1) + dy * dy <= limit)
+	{
+	  dx++;
+	}
+      if(y - dy >= clip.y0 && y - dy <= clip.y1)
+	{
+	  _SectorRow(sec, x, y, -dy, dx);
+	}
+      if(dy != 0 && y + dy >= clip.y0 && y + dy <= clip.y1)
+	{
+	  _SectorRow(sec, x, y, dy, dx);
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _DrawArc(int x ,int y ,int radius ,const struct _sector *sec)
+* @brief     Draw the points of the circle (as _Draw_Circle()) which are in
+*            the sector.
+********************************************************************************
+**/
+static void _DrawArc(int x ,int y ,int radius ,const struct _sector *sec)
+{
+  int f = 1 - radius;
+  int ddF_x = 1;
+  int ddF_y = -2 * radius;
+  int x1 = 0;
+  int y1 = radius;
+  int i, n;
+  int px[8], py[8];
+
+  while(x1 <= y1)
+    {
+      /* the 8 mirrored points ,the same point is not drawn twice */
+      px[0] = x1;  py[0] = y1;
+      px[1] = x1;  py[1] = -y1;
+      px[2] = y1;  py[2] = x1;
+      px[3] = -y1; py[3] = x1;
+      px[4] = -x1; py[4] = y1;
+      px[5] = -x1; py[5] = -y1;
+      px[6] = y1;  py[6] = -x1;
+      px[7] = -y1; py[7] = -x1;
+      n = (x1 == 0)? 4 : 8;
+      if(x1 == y1)
+	{
+	  px[2] = -x1; py[2] = y1;
+	  px[3] = -x1; py[3] = -y1;
+	  n = 4;
+	}
+      for(i = 0; i < n; i++)
+	{
+	  if(_InSector(sec, px[i], py[i]))
+	    {
+	      _DrawPoint(x + px[i], y + py[i]);
+	    }
+	}
+
+      if(f >= 0) 
+	{
+	  y1--;
+	  ddF_y += 2;
+	  f += ddF_y;
+	}
+      x1++;
+      ddF_x += 2;
+      f += ddF_x;    
+    }
+}
+
+/**
+********************************************************************************
+* @function  int _ArcArgs(unsigned char **args ,int arg_num ,int *v,
+*                         struct _sector *sec)
+* @brief     Get x ,y ,radius ,start ,end of an arc or pie command.
+* @return    0  --> succeed ,something may be in the clip rectangle
+*            -1 --> wrong parameters or nothing to draw
+********************************************************************************
+**/
+static int _ArcArgs(unsigned char **args ,int arg_num ,int *v,
+		    struct _sector *sec)
+{
+  unsigned int count;
+
+  if(arg_num != 5)
+    {
+      return -1;
+    }
+  for(count = 0; count < 5; count++)
+    {
+      v[count] = str_to_int(*(args + count));
+    }
+  if(v[0] > POLY_MAX_COORD || v[0] < -POLY_MAX_COORD ||
+     v[1] > POLY_MAX_COORD || v[1] < -POLY_MAX_COORD ||
+     v[2] > POLY_MAX_COORD || v[2] < 0 || v[3] == v[4])
+    {
+      return -1;
+    }
+  if(v[0] + v[2] < clip.x0 || v[0] - v[2] > clip.x1 ||
+     v[1] + v[2] < clip.y0 || v[1] - v[2] > clip.y1)
+    {
+      return -1;
+    }
+  _SetSector(sec, v[3], v[4]);
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  void DrawArc(unsigned char **args ,int arg_num)
+* @brief     AT+da=x,y,r,start,end
+*            Draw an arc of the circle (x ,y ,r) from 'start' to 'end'
+*            degrees ,counter-clockwise from 3 o'clock.
+********************************************************************************
+**/
+static void DrawArc(unsigned char **args ,int arg_num)
+{
+  struct _sector sec;
+  int v[5];
+
+  if(_ArcArgs(args, arg_num, v, &sec) == 0)
+    {
+      _DrawArc(v[0], v[1], v[2], &sec);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void FillArc(unsigned char **args ,int arg_num)
+* @brief     AT+fa=x,y,r,start,end
+*            Fill a pie slice ,the angles are the same as AT+da.
+********************************************************************************
+**/
+static void FillArc(unsigned char **args ,int arg_num)
+{
+  struct _sector sec;
+  int v[5];
+
+  if(_ArcArgs(args, arg_num, v, &sec) == 0)
+    {
+      _FillPie(v[0], v[1], v[2], &sec);
+    }
+}
+
+/**
+********************************************************************************
+* @micro    BEZIER_xxx
+* @brief    Adaptive forward differencing of Bezier curves.
+*           The curve is walked with the step h = 1 / 2^level of t ,the
+*           points and their forward differences are 32.32 fixed point.
+*           A step is halved while the second difference (8 times the
+*           distance of the curve from the segment) is over
+*           BEZIER_FLAT_MAX ,and doubled while it is under BEZIER_FLAT_MIN
+*           and the segment is shorter than BEZIER_SEG_MAX.
+********************************************************************************
+**/
+#define BEZIER_FRAC       32
+#define BEZIER_ONE        ((int64_t)1 << BEZIER_FRAC)
+#define BEZIER_FLAT_MAX   (BEZIER_ONE * 2)
+#define BEZIER_FLAT_MIN   (BEZIER_ONE / 4)
+#define BEZIER_SEG_MAX    (BEZIER_ONE * 16)
+#define BEZIER_LEVEL      4     /* the first step ,1/16 */
+#define BEZIER_LEVEL_MAX  10    /* 1024 segments at most */
+
+/**
+********************************************************************************
+* @function  int64_t _Abs64(int64_t v)
+********************************************************************************
+**/
+static int64_t _Abs64(int64_t v)
+{
+  return (v < 0)? -v : v;
+}
+
+/**
+********************************************************************************
+* @function  void _Bezier(const int *a ,const int *b ,const int *c ,
+*                         const int *d)
+* @brief     Draw the curve p(t) = a*t^3 + b*t^2 + c*t + d ,t = 0 ~ 1 ,as
+*            line segments (_DrawLine()).
+*            a ,b ,c ,d --> the polynomial coefficients ,[0] x ,[1] y
+********************************************************************************
+**/
+static void _Bezier(const int *a ,const int *b ,const int *c ,const int *d)
+{
+  int64_t p[2], d1[2], d2[2], d3[2], flat, len;
+  unsigned int level = BEZIER_LEVEL, k;
+  uint32_t t = 0, step;
+  int x0, y0, x1, y1;
+
+  /* forward differences for h = 1/16 */
+  for(k = 0; k < 2; k++)
+    {
+      p[k] = (int64_t)d[k] << BEZIER_FRAC;
+      d3[k] = ((int64_t)a[k] * 6) << (BEZIER_FRAC - 3 * BEZIER_LEVEL);
+      d2[k] = d3[k] + ((int64_t)b[k] << (BEZIER_FRAC + 1 - 2 * BEZIER_LEVEL));
+      d1[k] = ((int64_t)a[k] << (BEZIER_FRAC - 3 * BEZIER_LEVEL)) +
+	((int64_t)b[k] << (BEZIER_FRAC - 2 * BEZIER_LEVEL)) +
+	((int64_t)c[k] << (BEZIER_FRAC - BEZIER_LEVEL));
+    }
+
+  x0 = d[0];
+  y0 = d[1];
+  while(t < 0x10000)
+    {
+      step = 0x10000 >> level;
+
+      /* halve the step while the segment is too far from the curve */
+      flat = _Abs64(d2[0]) > _Abs64(d2[1])? _Abs64(d2[0]) : _Abs64(d2[1]);
+      if(flat > BEZIER_FLAT_MAX && level < BEZIER_LEVEL_MAX)
+	{
+	  for(k = 0; k < 2; k++)
+	    {
+	      d3[k] >>= 3;
+	      d2[k] = (d2[k] >> 2) - d3[k];
+	      d1[k] = (d1[k] - d2[k]) >> 1;
+	    }
+	  level++;
+	  continue;
+	}
+
+      /* double it while the curve is flat and the segment short */
+      len = _Abs64(d1[0]) > _Abs64(d1[1])? _Abs64(d1[0]) : _Abs64(d1[1]);
+      if(flat < BEZIER_FLAT_MIN && len < BEZIER_SEG_MAX / 2 &&
+	 level > 0 && (t & ((step << 1) - 1)) == 0 &&
+	 t + (step << 1) <= 0x10000)
+	{
+	  for(k = 0; k < 2; k++)
+	    {
+	      d1[k] = (d1[k] << 1) + d2[k];
+	      d2[k] = (d2[k] + d3[k]) << 2;
+	      d3[k] <<= 3;
+	    }
+	  level--;
+	  continue;
+	}
+
+      /* one step */
+      for(k = 0; k < 2; k++)
+	{
+	  p[k] += d1[k];
+	  d1[k] += d2[k];
+	  d2[k] += d3[k];
+	}
+      t += step;
+
+      if(t >= 0x10000)    /* the last point is exact */
+	{
+	  x1 = a[0] + b[0] + c[0] + d[0];
+	  y1 = a[1] + b[1] + c[1] + d[1];
+	}
+      else
+	{
+	  x1 = (int)((p[0] + (BEZIER_ONE >> 1)) >> BEZIER_FRAC);
+	  y1 = (int)((p[1] + (BEZIER_ONE >> 1)) >> BEZIER_FRAC);
+	}
+      if(x1 != x0 || y1 != y0)
+	{
+	  _DrawLine(x0, y0, x1, y1);
+	  x0 = x1;
+	  y0 = y1;
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  int _BezierArgs(unsigned char **args ,int arg_num ,int *xy)
+* @brief     Get the control points of a Bezier command.
+* @return    0  --> succeed ,the curve may be in the clip rectangle
+*            -1 --> wrong parameters or nothing to draw
+********************************************************************************
+**/
+static int _BezierArgs(unsigned char **args ,int arg_num ,int *xy)
+{
+  int x_min = POLY_MAX_COORD, x_max = -POLY_MAX_COORD;
+  int y_min = POLY_MAX_COORD, y_max = -POLY_MAX_COORD;
+  unsigned int count;
+
+  for(count = 0; count < (unsigned int)arg_num; count++)
+    {
+      xy[count] = str_to_int(*(args + count));
+      if(xy[count] > POLY_MAX_COORD || xy[count] < -POLY_MAX_COORD)
+	{
+	  return -1;
+	}
+    }
+
+  /* the curve is in the box of its control points */
+  for(count = 0; count < (unsigned int)arg_num; count += 2)
+    {
+      x_min = (xy[count] < x_min)? xy[count] : x_min;
+      x_max = (xy[count] > x_max)? xy[count] : x_max;
+      y_min = (xy[count + 1] < y_min)? xy[count + 1] : y_min;
+      y_max = (xy[count + 1] > y_max)? xy[count + 1] : y_max;
+    }
+  if(x_max < clip.x0 || x_min > clip.x1 || y_max < clip.y0 || y_min > clip.y1)
+    {
+      return -1;
+    }
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  void DrawQuadBezier(unsigned char **args ,int arg_num)
+* @brief     AT+qb=x0,y0,x1,y1,x2,y2
+*            Draw a quadratic Bezier curve from (x0 ,y0) to (x2 ,y2) ,
+*            (x1 ,y1) is the control point.
+********************************************************************************
+**/
+static void DrawQuadBezier(unsigned char **args ,int arg_num)
+{
+  int xy[6], a[2], b[2], c[2];
+  unsigned int k;
+
+  if(arg_num != 6 || _BezierArgs(args, arg_num, xy) != 0)
+    {
+      return;
+    }
+  for(k = 0; k < 2; k++)
+    {
+      a[k] = 0;
+      b[k] = xy[k] - 2 * xy[2 + k] + xy[4 + k];
+      c[k] = 2 * (xy[2 + k] - xy[k]);
+    }
+  _Bezier(a, b, c, xy);
+}
+
+/**
+********************************************************************************
+* @function  void DrawCubicBezier(unsigned char **args ,int arg_num)
+* @brief     AT+cb=x0,y0,x1,y1,x2,y2,x3,y3
+*            Draw a cubic Bezier curve from (x0 ,y0) to (x3 ,y3) ,
+*            (x1 ,y1) and (x2 ,y2) are the control points.
+********************************************************************************
+**/
+static void DrawCubicBezier(unsigned char **args ,int arg_num)
+{
+  int xy[8], a[2], b[2], c[2];
+  unsigned int k;
+
+  if(arg_num != 8 || _BezierArgs(args, arg_num, xy) != 0)
+    {
+      return;
+    }
+  for(k = 0; k < 2; k++)
+    {
+      a[k] = -xy[k] + 3 * xy[2 + k] - 3 * xy[4 + k] + xy[6 + k];
+      b[k] = 3 * xy[k] - 6 * xy[2 + k] + 3 * xy[4 + k];
+      c[k] = 3 * (xy[2 + k] - xy[k]);
+    }
+  _Bezier(a, b, c, xy);
+}
+
+/**
+********************************************************************************
+* @variable stroke
+* @brief    Stroke style of AT+dl ,AT+dr ,AT+dc and AT+dR (set by AT+st).
+*           width     --> 1 ~ STROKE_MAX_WIDTH pixels ,a stroke covers
+*                         width / 2 pixels outside the path and
+*                         (width - 1) / 2 inside it
+*           dash_on   --> pixels drawn ,then
+*           dash_off  --> pixels skipped ,either 0 : a solid stroke
+*           cap       --> STROKE_CAP_xxx ,the ends of thick lines and their
+*                         dashes
+*           The dash pattern starts again at the start of every command.
+*           phase , seg_pos , seg_len , unit --> dash walker ,see _DashNext()
+*           Every pixel of a shape is sent once : thick lines are
+*           polygons ,closed shapes are bands and rings sent as spans.
+*           Only square and round caps reach into a dash gap shorter than
+*           the width ,and may then cover the next dash.
+********************************************************************************
+**/
+#define STROKE_MAX_WIDTH 32
+
+#define STROKE_CAP_BUTT   0
+#define STROKE_CAP_SQUARE 1
+#define STROKE_CAP_ROUND  2
+
+struct _stroke
+{
+  int width;
+  int dash_on;
+  int dash_off;
+  unsigned char cap;
+  int phase;
+  int seg_pos;
+  int seg_len;
+  int unit;
+};
+
+static struct _stroke stroke = {1, 0, 0, STROKE_CAP_BUTT, 0, 0, 0, 1};
+
+/**
+********************************************************************************
+* @function  uint32_t _ISqrt(uint64_t v)
+* @brief     Integer square root ,floor(sqrt(v)).
+********************************************************************************
+**/
+static uint32_t _ISqrt(uint64_t v)
+{
+  uint64_t root = 0, bit = (uint64_t)1 << 62;
+
+  while(bit > v)
+    {
+      bit >>= 2;
+    }
+  while(bit != 0)
+    {
+      if(v >= root + bit)
+	{
+	  v -= root + bit;
+	  root = (root >> 1) + bit;
+	}
+      else
+	{
+	  root >>= 1;
+	}
+      bit >>= 2;
+    }
+  return (uint32_t)root;
+}
+
+/**
+********************************************************************************
+* @function  void _DashStart(int len)
+* @brief     Start a path piece of 'len' units for _DashNext().
+*            The dash phase goes on from the last piece.
+********************************************************************************
+**/
+static void _DashStart(int len)
+{
+  stroke.seg_pos = 0;
+  stroke.seg_len = len;
+}
+
+/**
+********************************************************************************
+* @function  int _DashNext(int *s ,int *e)
+* @brief     Get the next dash of the path piece set by _DashStart().
+*            The dash covers the units *s ~ *e - 1 of the piece ,a unit is
+*            1 / stroke.unit pixel.
+* @return    1 --> a dash
+*            0 --> the piece is finished
+********************************************************************************
+**/
+static int _DashNext(int *s ,int *e)
+{
+  int on = stroke.dash_on * stroke.unit;
+  int period = on + stroke.dash_off * stroke.unit;
+  int take, in;
+
+  if(stroke.dash_on == 0 || stroke.dash_off == 0)    /* solid */
+    {
+      if(stroke.seg_pos >= stroke.seg_len)
+	{
+	  return 0;
+	}
+      *s = 0;
+      *e = stroke.seg_len;
+      stroke.seg_pos = stroke.seg_len;
+      return 1;
+    }
+
+  while(stroke.seg_pos < stroke.seg_len)
+    {
+      in = (stroke.phase < on);
+      take = (in? on : period) - stroke.phase;
+      if(take > stroke.seg_len - stroke.seg_pos)
+	{
+	  take = stroke.seg_len - stroke.seg_pos;
+	}
+      *s = stroke.seg_pos;
+      stroke.seg_pos += take;
+      stroke.phase = (stroke.phase + take) % period;
+      if(in)
+	{
+	  *e = stroke.seg_pos;
+	  return 1;
+	}
+    }
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  void _StrokePiece(int32_t ax ,int32_t ay ,int32_t bx ,int32_t by,
+*                              int ux ,int uy)
+* @brief     Fill one thick line piece from a to b (28.4 ,the outer ends of
+*            the end pixels) with the cap style.
+*            u is the Q14 unit vector from a to b.
+*            Butt : a rectangle. Square : a rectangle longer by the half
+*            width (less the half pixel already in a ~ b) at both ends.
+*            Round : a rectangle with a half circle (7 vertices) at both
+*            ends ,centred half a pixel inside them. Every piece is one
+*            convex polygon ,so no pixel is sent twice.
+********************************************************************************
+**/
+static void _StrokePiece(int32_t ax ,int32_t ay ,int32_t bx ,int32_t by,
+			 int ux ,int uy)
+{
+  /* cos and sin of -90 ~ 90 degrees in steps of 30 ,Q14 */
+  static const int16_t cap_cos[7] = {0, 8192, 14189, 16384, 14189, 8192, 0};
+  static const int16_t cap_sin[7] = {-16384, -14189, -8192, 0,
+				     8192, 14189, 16384};
+  int xy[POLY_MAX_VERTEX * 2];
+  int32_t h = stroke.width << (POLY_FRAC - 1);    /* half width */
+  int32_t half = 1 << (POLY_FRAC - 1);            /* half pixel */
+  int32_t nx, ny, hx, hy, ext, len;
+  unsigned int i, n = 0;
+
+  hx = (ux * h) >> 14;     /* u * half width */
+  hy = (uy * h) >> 14;
+  nx = -hy;                /* normal * half width */
+  ny = hx;
+
+  if(stroke.cap == STROKE_CAP_ROUND)
+    {
+      len = (int32_t)(((int64_t)(bx - ax) * ux + (int64_t)(by - ay) * uy)
+		      >> 14);
+      ext = (len < 2 * half)? (len >> 1) : half;
+      ax += (ux * ext) >> 14;
+      ay += (uy * ext) >> 14;
+      bx -= (ux * ext) >> 14;
+      by -= (uy * ext) >> 14;
+
+      for(i = 0; i < 7; i++)    /* b end ,from -n over u to +n */
+	{
+	  xy[n++] = bx + ((hx * cap_cos[i] + nx * cap_sin[i]) >> 14);
+	  xy[n++] = by + ((hy * cap_cos[i] + ny * cap_sin[i]) >> 14);
+	}
+      for(i = 0; i < 7; i++)    /* a end ,from +n over -u to -n */
+	{
+	  xy[n++] = ax - ((hx * cap_cos[i] + nx * cap_sin[i]) >> 14);
+	  xy[n++] = ay - ((hy * cap_cos[i] + ny * cap_sin[i]) >> 14);
+	}
+      _FillPolygon(xy, n >> 1, POLY_EVEN_ODD, _FillSpans);
+      return;
+    }
+
+  if(stroke.cap == STROKE_CAP_SQUARE)
+    {
+      ext = h - half;
+      ax -= (ux * ext) >> 14;
+      ay -= (uy * ext) >> 14;
+      bx += (ux * ext) >> 14;
+      by += (uy * ext) >> 14;
+    }
+  xy[0] = ax - nx;  xy[1] = ay - ny;
+  xy[2] = bx - nx;  xy[3] = by - ny;
+  xy[4] = bx + nx;  xy[5] = by + ny;
+  xy[6] = ax + nx;  xy[7] = ay + ny;
+  _FillPolygon(xy, 4, POLY_EVEN_ODD, _FillSpans);
+}
+
+/**
+********************************************************************************
+* @function  int _DivRound(int a ,int b)
+* @brief     a / b rounded to the nearest integer ,b > 0.
+********************************************************************************
+**/
+static int _DivRound(int a ,int b)
+{
+  return (a >= 0)? (a + b / 2) / b : -((-a + b / 2) / b);
+}
+
+/**
+********************************************************************************
+* @function  void _StrokeLine(int x0 ,int y0 ,int x1 ,int y1)
+* @brief     Draw a line with the stroke style.
+*            1 pixel wide : the dashes are counted in pixels along the main
+*            axis and drawn by _DrawLine().
+*            Thicker : the path runs from the outer end of the first pixel
+*            to the outer end of the last one ,every dash is a polygon
+*            (_StrokePiece()).
+********************************************************************************
+**/
+static void _StrokeLine(int x0 ,int y0 ,int x1 ,int y1)
+{
+  int dx = x1 - x0, dy = y1 - y0;
+  int len, s, e;
+  int32_t ax, ay, len16;
+  int ux, uy;
+
+  if(stroke.width == 1)
+    {
+      len = ((dx < 0)? -dx : dx) > ((dy < 0)? -dy : dy)?
+	((dx < 0)? -dx : dx) : ((dy < 0)? -dy : dy);
+      stroke.unit = 1;
+      _DashStart(len + 1);
+      while(_DashNext(&s, &e))
+	{
+	  e--;
+	  if(len == 0)
+	    {
+	      _DrawPoint(x0, y0);
+	      continue;
+	    }
+	  _DrawLine(x0 + _DivRound(dx * s, len), y0 + _DivRound(dy * s, len),
+		    x0 + _DivRound(dx * e, len), y0 + _DivRound(dy * e, len));
+	}
+      return;
+    }
+
+  len16 = (int32_t)_ISqrt(((uint64_t)((int64_t)dx * dx + (int64_t)dy * dy))
+			  << (2 * POLY_FRAC));
+  if(len16 == 0)
+    {
+      ux = 1 << 14;    /* a dot ,any direction */
+      uy = 0;
+    }
+  else
+    {
+      ux = (int)(((int64_t)dx << (14 + POLY_FRAC)) / len16);
+      uy = (int)(((int64_t)dy << (14 + POLY_FRAC)) / len16);
+    }
+
+  /* from the outer end of the first pixel ,1 pixel longer than the line */
+  ax = ((int32_t)x0 << POLY_FRAC) + (1 << (POLY_FRAC - 1)) -
+    ((ux << (POLY_FRAC - 1)) >> 14);
+  ay = ((int32_t)y0 << POLY_FRAC) + (1 << (POLY_FRAC - 1)) -
+    ((uy << (POLY_FRAC - 1)) >> 14);
+  len16 += 1 << POLY_FRAC;
+
+  stroke.unit = 1 << POLY_FRAC;
+  _DashStart(len16);
+  while(_DashNext(&s, &e))
+    {
+      /* s ,e go up to about 2^17.5 ,u * s needs 64 bits */
+      _StrokePiece(ax + (int32_t)(((int64_t)ux * s) >> 14),
+		   ay + (int32_t)(((int64_t)uy * s) >> 14),
+		   ax + (int32_t)(((int64_t)ux * e) >> 14),
+		   ay + (int32_t)(((int64_t)uy * e) >> 14), ux, uy);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _StrokeBand(int x0 ,int y0 ,int x1 ,int y1 ,int len ,
+*                             int dir)
+* @brief     Dash one straight side of a closed stroke.
+*            The side is the band x0 ~ x1 ,y0 ~ y1 ,walked 'len' pixels :
+*            dir 0 --> to the right (x0 ...)   dir 1 --> down (y0 ...)
+*            dir 2 --> to the left (... x1)    dir 3 --> up (... y1)
+********************************************************************************
+**/
+static void _StrokeBand(int x0 ,int y0 ,int x1 ,int y1 ,int len ,int dir)
+{
+  int s, e;
+
+  if(len <= 0)
+    {
+      return;
+    }
+  _DashStart(len);
+  while(_DashNext(&s, &e))
+    {
+      switch(dir)
+	{
+	case 0:
+	  _FillSpans(x0 + s, x0 + e - 1, y0, y1 - y0 + 1);
+	  break;
+	case 1:
+	  _FillSpans(x0, x1, y0 + s, e - s);
+	  break;
+	case 2:
+	  _FillSpans(x1 - e + 1, x1 - s, y0, y1 - y0 + 1);
+	  break;
+	default:
+	  _FillSpans(x0, x1, y1 - e + 1, e - s);
+	  break;
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _StrokeRect(int x0 ,int y0 ,int x1 ,int y1)
+* @brief     Draw a rectangle with the stroke style.
+*            The sides are 4 bands that do not overlap ,each owns the corner
+*            at its start : top (left to right) ,right (down) ,bottom
+*            (right to left) ,left (up).
+*            Note: x0 <= x1 , y0 <= y1
+********************************************************************************
+**/
+static void _StrokeRect(int x0 ,int y0 ,int x1 ,int y1)
+{
+  int eo = stroke.width >> 1, ei = (stroke.width - 1) >> 1;
+  int side;
+
+  if(x1 - x0 <= 2 * ei + 1 || y1 - y0 <= 2 * ei + 1)    /* no hole */
+    {
+      _FillSpans(x0 - eo, x1 + eo, y0 - eo, y1 - y0 + 2 * eo + 1);
+      return;
+    }
+
+  side = x1 - x0 + eo - ei;
+  stroke.unit = 1;
+  _StrokeBand(x0 - eo, y0 - eo, x1 - ei - 1, y0 + ei, side, 0);
+  _StrokeBand(x1 - ei, y0 - eo, x1 + eo, y1 - ei - 1,
+	      y1 - y0 + eo - ei, 1);
+  _StrokeBand(x0 + ei + 1, y1 - ei, x1 + eo, y1 + eo, side, 2);
+  _StrokeBand(x0 - eo, y0 + ei + 1, x0 + ei, y1 + eo,
+	      y1 - y0 + eo - ei, 3);
+}
+
+/**
+********************************************************************************
+* @function  int _RRectRow(int x0 ,int y0 ,int x1 ,int y1 ,int r ,int y,
+*                          int *l ,int *rt)
+* @brief     The pixels *l ~ *rt of row y in the filled round rectangle
+*            (the same pixels as _RoundRectSpans() fills).
+*            r < 0 : no round rectangle.
+* @return    0  --> the row is in the round rectangle
+*            -1 --> it is not
+********************************************************************************
+**/
+static int _RRectRow(int x0 ,int y0 ,int x1 ,int y1 ,int r ,int y,
+		     int *l ,int *rt)
+{
+  int dy = 0, dx;
+
+  if(r < 0 || x0 > x1 || y < y0 || y > y1)
+    {
+      return -1;
+    }
+  if(y < y0 + r)
+    {
+      dy = y0 + r - y;
+    }
+  else if(y > y1 - r)
+    {
+      dy = y - (y1 - r);
+    }
+  dx = (int)_ISqrt((uint64_t)(r * r + r - dy * dy));
+  *l = x0 + r - dx;
+  *rt = x1 - r + dx;
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  void _StrokeRing(int x0 ,int y0 ,int x1 ,int y1 ,int r)
+* @brief     Draw a round rectangle (a circle is (x-r ,y-r ,x+r ,y+r ,r))
+*            with a solid stroke : the outer round rectangle without the
+*            inner one ,at most 2 spans a row. Rows with the same spans are
+*            sent as one window.
+********************************************************************************
+**/
+static void _StrokeRing(int x0 ,int y0 ,int x1 ,int y1 ,int r)
+{
+  int eo = stroke.width >> 1, ei = ((stroke.width - 1) >> 1) + 1;
+  int ir = (r - ei < 0)? 0 : r - ei;
+  int y, ystart, yend, l, rt, il, ir_x, n;
+  int span[4], last[4], start = 0, h = 0, count = 0;
+
+  ystart = (y0 - eo > clip.y0)? y0 - eo : clip.y0;
+  yend = (y1 + eo < clip.y1)? y1 + eo : clip.y1;
+  for(y = ystart; y <= yend + 1; y++)
+    {
+      n = 0;
+      if(y <= yend &&
+	 _RRectRow(x0 - eo, y0 - eo, x1 + eo, y1 + eo, r + eo, y, &l, &rt) == 0)
+	{
+	  if(_RRectRow(x0 + ei, y0 + ei, x1 - ei, y1 - ei, ir, y,
+		       &il, &ir_x) == 0)
+	    {
+	      span[0] = l;       span[1] = il - 1;
+	      span[2] = ir_x + 1; span[3] = rt;
+	      n = 4;
+	    }
+	  else
+	    {
+	      span[0] = l;  span[1] = rt;
+	      n = 2;
+	    }
+	}
+
+      if(h != 0 && (n != count || memcmp(span, last, n * sizeof(int)) != 0))
+	{
+	  _FillSpans(last[0], last[1], start, h);
+	  if(count == 4)
+	    {
+	      _FillSpans(last[2], last[3], start, h);
+	    }
+	  h = 0;
+	}
+      if(n != 0)
+	{
+	  if(h == 0)
+	    {
+	      memcpy(last, span, sizeof(span));
+	      count = n;
+	      start = y;
+	    }
+	  h++;
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _StrokeCorner(int cx ,int cy ,int r ,int from ,int len)
+* @brief     Dash a quarter circle corner of a closed stroke.
+*            The corner is walked clockwise from 'from' (1/16 degrees) for
+*            'len' pixels (the length at radius r) ,every dash is the part
+*            of the ring around (cx ,cy) between the dash angles.
+********************************************************************************
+**/
+static void _StrokeCorner(int cx ,int cy ,int r ,int from ,int len)
+{
+  struct _sector sec;
+  int eo = stroke.width >> 1, ei = ((stroke.width - 1) >> 1) + 1;
+  int ro = r + eo, ri = r - ei;
+  int s, e, dy, dxo, dxi, lo, hi, dy0, dy1;
+
+  _DashStart(len);
+  if(cx - ro > clip.x1 || cx + ro < clip.x0 ||
+     cy - ro > clip.y1 || cy + ro < clip.y0)    /* only keep the phase */
+    {
+      while(_DashNext(&s, &e));
+      return;
+    }
+  dy0 = (cy - ro > clip.y0)? -ro : clip.y0 - cy;    /* rows in the clip */
+  dy1 = (cy + ro < clip.y1)? ro : clip.y1 - cy;
+  while(_DashNext(&s, &e))
+    {
+      /* clockwise : the dash end is the smaller angle ,the ray of the
+	 start belongs to the piece before */
+      _AngleVector((from - (e * 1440) / len + 5760) % 5760,
+		   &sec.start_x, &sec.start_y);
+      _AngleVector((from - (s * 1440) / len + 5760) % 5760,
+		   &sec.end_x, &sec.end_y);
+      for(dy = dy0; dy <= dy1; dy++)
+	{
+	  dxo = (int)_ISqrt((uint64_t)(ro * ro + ro - dy * dy));
+	  dxi = (ri >= 0 && dy >= -ri && dy <= ri)?
+	    (int)_ISqrt((uint64_t)(ri * ri + ri - dy * dy)) : -1;
+	  lo = -dxo;
+	  hi = dxo;
+	  _HalfPlane(-sec.start_y, sec.start_x * -dy, &lo, &hi);
+	  _HalfPlane(sec.end_y, -sec.end_x * -dy - 1, &lo, &hi);
+	  if(dxi < 0)
+	    {
+	      if(lo <= hi)
+		{
+		  _FillSpans(cx + lo, cx + hi, cy + dy, 1);
+		}
+	      continue;
+	    }
+	  if(lo <= -dxi - 1)
+	    {
+	      _FillSpans(cx + lo, cx + ((hi < -dxi - 1)? hi : -dxi - 1),
+			 cy + dy, 1);
+	    }
+	  if(hi >= dxi + 1)
+	    {
+	      _FillSpans(cx + ((lo > dxi + 1)? lo : dxi + 1), cx + hi,
+			 cy + dy, 1);
+	    }
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _StrokeRRect(int x0 ,int y0 ,int x1 ,int y1 ,int r)
+* @brief     Draw a round rectangle or a circle with the stroke style.
+*            Solid : _StrokeRing(). Dashed : the path is walked clockwise
+*            from the top left ,the straight sides are bands and the
+*            corners rings ,every piece owns the pixels on the ray (or
+*            the row) at its end.
+*            Note: x0 <= x1 , y0 <= y1 , (r << 1) <= x1 - x0 , y1 - y0
+********************************************************************************
+**/
+static void _StrokeRRect(int x0 ,int y0 ,int x1 ,int y1 ,int r)
+{
+  int eo = stroke.width >> 1, ei = (stroke.width - 1) >> 1;
+  int corner = (r * 402) >> 8;    /* pi / 2 * r */
+
+  if(x0 - eo > clip.x1 || x1 + eo < clip.x0 ||
+     y0 - eo > clip.y1 || y1 + eo < clip.y0)
+    {
+      return;
+    }
+  if(stroke.dash_on == 0 || stroke.dash_off == 0 ||
+     x1 - x0 <= 2 * ei + 1 || y1 - y0 <= 2 * ei + 1)    /* solid or no hole */
+    {
+      _StrokeRing(x0, y0, x1, y1, r);
+      return;
+    }
+  if(r <= ei || corner == 0)    /* the corners have no inner edge */
+    {
+      _StrokeRect(x0, y0, x1, y1);
+      return;
+    }
+
+  stroke.unit = 1;
+  _StrokeBand(x0 + r + 1, y0 - eo, x1 - r, y0 + ei, x1 - x0 - 2 * r, 0);
+  _StrokeCorner(x1 - r, y0 + r, r, 1440, corner);
+  _StrokeBand(x1 - ei, y0 + r + 1, x1 + eo, y1 - r, y1 - y0 - 2 * r, 1);
+  _StrokeCorner(x1 - r, y1 - r, r, 5760, corner);
+  _StrokeBand(x0 + r, y1 - ei, x1 - r - 1, y1 + eo, x1 - x0 - 2 * r, 2);
+  _StrokeCorner(x0 + r, y1 - r, r, 4320, corner);
+  _StrokeBand(x0 - eo, y0 + r, x0 + ei, y1 - r - 1, y1 - y0 - 2 * r, 3);
+  _StrokeCorner(x0 + r, y0 + r, r, 2880, corner);
+}
+
+/**
+********************************************************************************
+* @variable anti_alias , aa_ramp , aa_front , aa_back , aa_valid
+* @brief    Anti-aliased strokes (set by AT+aa).
+*           The edge pixels of a stroke get the colour of their coverage ,
+*           blended from front_color into back_color. The screen is not
+*           read back ,so the shapes are meant for a back_color background.
+*           aa_ramp[k] is the colour of the coverage k / AA_LEVELS (0 is
+*           back_color ,AA_LEVELS is front_color). The ramp is rebuilt only
+*           when one of the two colors changed.
+*           Fully covered pixels still go out as spans ,the edge pixels
+*           of a row are joined into runs (aa_run) sent as one burst.
+********************************************************************************
+**/
+#define AA_BITS   4
+#define AA_LEVELS (1 << AA_BITS)
+#define AA_RUN_MAX (LCD_LINE_WORDS * 2)
+
+static unsigned char anti_alias = 0;
+static uint16_t aa_ramp[AA_LEVELS + 1];
+static unsigned int aa_front = 0, aa_back = 0;
+static unsigned char aa_valid = 0;
+
+/**
+********************************************************************************
+* @variable aa_run
+* @brief    The edge pixel run being built in line_buf.
+*           x , y --> the first pixel   n --> the pixels' number
+********************************************************************************
+**/
+struct _aa_run
+{
+  int x;
+  int y;
+  int n;
+};
+
+static struct _aa_run aa_run = {0, 0, 0};
+
+/**
+********************************************************************************
+* @function  void _UpdateAARamp(void)
+* @brief     Rebuild aa_ramp[] if front_color or back_color changed.
+*            Every RGB565 channel is blended on its own ,rounded.
+********************************************************************************
+**/
+static void _UpdateAARamp(void)
+{
+  unsigned int k, r, g, b;
+
+  if(aa_valid != 0 && aa_front == front_color && aa_back == back_color)
+    {
+      return;
+    }
+
+  for(k = 0; k <= AA_LEVELS; k++)
+    {
+      r = (((front_color >> 11) & 0x1f) * k +
+	   ((back_color >> 11) & 0x1f) * (AA_LEVELS - k) +
+	   AA_LEVELS / 2) >> AA_BITS;
+      g = (((front_color >> 5) & 0x3f) * k +
+	   ((back_color >> 5) & 0x3f) * (AA_LEVELS - k) +
+	   AA_LEVELS / 2) >> AA_BITS;
+      b = ((front_color & 0x1f) * k + (back_color & 0x1f) * (AA_LEVELS - k) +
+	   AA_LEVELS / 2) >> AA_BITS;
+      aa_ramp[k] = (uint16_t)((r << 11) | (g << 5) | b);
+    }
+
+  aa_front = front_color;
+  aa_back = back_color;
+  aa_valid = 1;
+}
+
+/**
+********************************************************************************
+* @function  void _AAFlush(void)
+* @brief     Send the edge pixel run ,one cursor move and one burst.
+********************************************************************************
+**/
+static void _AAFlush(void)
+{
+  if(aa_run.n == 0)
+    {
+      return;
+    }
+  SetSpan(aa_run.x, aa_run.x + aa_run.n - 1, aa_run.y);
+  lcd_write_pixels((const uint16_t *)line_buf, aa_run.n);
+  aa_run.n = 0;
+}
+
+/**
+********************************************************************************
+* @function  void _AAPut(int x ,int y ,unsigned int cov)
+* @brief     Add an edge pixel of coverage 'cov' (0 ~ AA_LEVELS) to the run.
+*            A pixel that does not follow the run on its row starts a new
+*            one. Pixels out of the clip rectangle and empty ones are left.
+********************************************************************************
+**/
+static void _AAPut(int x ,int y ,unsigned int cov)
+{
+  if(aa_run.n != 0 &&
+     (y != aa_run.y || x != aa_run.x + aa_run.n || aa_run.n == AA_RUN_MAX))
+    {
+      _AAFlush();
+    }
+  if(cov == 0 || x < clip.x0 || x > clip.x1 || y < clip.y0 || y > clip.y1)
+    {
+      return;
+    }
+  if(aa_run.n == 0)
+    {
+      aa_run.x = x;
+      aa_run.y = y;
+    }
+  ((uint16_t *)line_buf)[aa_run.n++] = aa_ramp[(cov > AA_LEVELS)?
+					       AA_LEVELS : cov];
+}
+
+/**
+********************************************************************************
+* @function  void _AASpan(int x0 ,int x1 ,int y ,int h ,unsigned int cov)
+* @brief     Fill the pixels x0 ~ x1 of the rows y ~ y + h - 1 with the
+*            colour of coverage 'cov' ,cut to the clip rectangle.
+********************************************************************************
+**/
+static void _AASpan(int x0 ,int x1 ,int y ,int h ,unsigned int cov)
+{
+  int y1 = y + h - 1;
+
+  _AAFlush();
+  if(cov == 0 || _ClipRect(&x0, &y, &x1, &y1) != 0)
+    {
+      return;
+    }
+  if(cov > AA_LEVELS)
+    {
+      cov = AA_LEVELS;
+    }
+  if(y == y1)
+    {
+      SetSpan(x0, x1, y);
+      lcd_fill_pixels(aa_ramp[cov], x1 - x0 + 1);
+    }
+  else
+    {
+      _FillWindow(x0, y, x1, y1, aa_ramp[cov]);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _AALinePiece(int x0 ,int y0 ,int x1 ,int y1 ,int m0 ,int m1)
+* @brief     Draw the part m0 ~ m1 (along the main axis) of the anti-aliased
+*            line from (x0 ,y0) to (x1 ,y1).
+*            Like Wu's lines the width is counted along the minor axis ,a
+*            pixel at the distance d (minor axis) from the line is covered
+*            width / 2 + 1 / 2 - d ,so a 1 pixel line is 2 pixels a column
+*            whose coverages add up to 1.
+*            Every row is cut in the covered pixels (two half planes) and the
+*            fully covered ones (two narrower half planes) ,the first are
+*            edge runs ,the second one span.
+*            E is the distance * 16 * D (D = the main axis length).
+*            With the ends in -CMD_MAX_COORD ~ CMD_MAX_COORD and the rows
+*            cut to the clip ,|E| stays under 2^31.
+********************************************************************************
+**/
+static void _AALinePiece(int x0 ,int y0 ,int x1 ,int y1 ,int m0 ,int m1)
+{
+  int dx, dy, d, k_out, k_solid, a, c, x, y, ys, ye, e;
+  int lo, hi, slo, shi, t;
+  int steep;
+
+  dx = x1 - x0;
+  dy = y1 - y0;
+  steep = (((dy < 0)? -dy : dy) > ((dx < 0)? -dx : dx));
+  if((steep == 0 && dx < 0) || (steep != 0 && dy < 0))
+    {
+      t = x0;  x0 = x1;  x1 = t;
+      t = y0;  y0 = y1;  y1 = t;
+      dx = -dx;
+      dy = -dy;
+    }
+  d = (steep != 0)? dy : dx;
+  if(d == 0)    /* a dot */
+    {
+      d = 1;
+    }
+  k_out = ((stroke.width << 3) + 8) * d;
+  k_solid = ((stroke.width << 3) - 8) * d;
+
+  if(steep != 0)
+    {
+      ys = m0;
+      ye = m1;
+    }
+  else
+    {
+      t = (((stroke.width << 3) + 8) >> 4) + 1;    /* the widest reach */
+      ys = ((y0 < y1)? y0 : y1) - t;
+      ye = ((y0 < y1)? y1 : y0) + t;
+    }
+  if(ys < clip.y0)
+    {
+      ys = clip.y0;
+    }
+  if(ye > clip.y1)
+    {
+      ye = clip.y1;
+    }
+
+  for(y = ys; y <= ye; y++)
+    {
+      if(steep != 0)    /* E = 16 * ((x - x0) * dy - (y - y0) * dx) */
+	{
+	  a = 16 * d;
+	  c = -16 * (x0 * d + (y - y0) * dx);
+	  lo = clip.x0;
+	  hi = clip.x1;
+	}
+      else              /* E = 16 * ((y - y0) * dx - (x - x0) * dy) */
+	{
+	  a = -16 * dy;
+	  c = 16 * ((y - y0) * d + x0 * dy);
+	  lo = (m0 > clip.x0)? m0 : clip.x0;
+	  hi = (m1 < clip.x1)? m1 : clip.x1;
+	}
+
+      /* covered : |E| < k_out */
+      _HalfPlane(-a, k_out - 1 - c, &lo, &hi);
+      _HalfPlane(a, c + k_out - 1, &lo, &hi);
+      if(lo > hi)
+	{
+	  continue;
+	}
+      /* fully covered : |E| <= k_solid */
+      slo = lo;
+      shi = hi;
+      _HalfPlane(-a, k_solid - c, &slo, &shi);
+      _HalfPlane(a, c + k_solid, &slo, &shi);
+      if(slo > shi)
+	{
+	  slo = hi + 1;
+	  shi = hi;
+	}
+
+      for(x = lo; x < slo; x++)
+	{
+	  e = a * x + c;
+	  _AAPut(x, y, (unsigned int)((k_out - ((e < 0)? -e : e)) / d));
+	}
+      if(slo <= shi)
+	{
+	  _AAFlush();
+	  _FillSpans(slo, shi, y, 1);
+	}
+      for(x = shi + 1; x <= hi; x++)
+	{
+	  e = a * x + c;
+	  _AAPut(x, y, (unsigned int)((k_out - ((e < 0)? -e : e)) / d));
+	}
+    }
+  _AAFlush();
+}
+
+/**
+********************************************************************************
+* @function  void _AALine(int x0 ,int y0 ,int x1 ,int y1)
+* @brief     Draw an anti-aliased line with the stroke width and dashes.
+*            The dashes are counted in pixels along the main axis ,square
+*            and round caps lengthen every dash by width / 2 at both ends
+*            (both are square here).
+********************************************************************************
+**/
+static void _AALine(int x0 ,int y0 ,int x1 ,int y1)
+{
+  int dx = x1 - x0, dy = y1 - y0;
+  int steep, start, dir, len, cap, s, e, m0, m1;
+
+  _UpdateAARamp();
+  steep = (((dy < 0)? -dy : dy) > ((dx < 0)? -dx : dx));
+  start = (steep != 0)? y0 : x0;
+  len = (steep != 0)? dy : dx;
+  dir = (len < 0)? -1 : 1;
+  len = (len < 0)? -len : len;
+  cap = (stroke.cap == STROKE_CAP_BUTT)? 0 : (stroke.width >> 1);
+
+  stroke.unit = 1;
+  _DashStart(len + 1);
+  while(_DashNext(&s, &e))
+    {
+      m0 = start + dir * s;
+      m1 = start + dir * (e - 1);
+      if(m0 > m1)
+	{
+	  s = m0;  m0 = m1;  m1 = s;
+	}
+      _AALinePiece(x0, y0, x1, y1, m0 - cap, m1 + cap);
+    }
+}
+
+/**
+********************************************************************************
+* @function  int _RingDx(int t ,int dy)
+* @brief     The largest dx >= 0 whose distance sqrt(dx * dx + dy * dy)
+*            (in 1/16 pixels ,rounded down) is t or less.
+* @return    dx ,-1 --> none
+********************************************************************************
+**/
+static int _RingDx(int t ,int dy)
+{
+  int64_t m;    /* t is up to 2^16 ,t * t needs 64 bits */
+
+  if(t < 0)
+    {
+      return -1;
+    }
+  m = (int64_t)(t + 1) * (t + 1) - 1 - ((int64_t)dy * dy << 8);
+  if(m < 0)
+    {
+      return -1;
+    }
+  return (int)_ISqrt((uint64_t)(m >> 8));
+}
+
+/**
+********************************************************************************
+* @function  unsigned int _RingCov(int dx ,int dy ,int r16 ,int w8)
+* @brief     Coverage of the pixel (dx ,dy) from the centre by the ring of
+*            radius r16 / 16 and width w8 / 8.
+********************************************************************************
+**/
+static unsigned int _RingCov(int dx ,int dy ,int r16 ,int w8)
+{
+  int d = (int)_ISqrt((uint64_t)(dx * dx + dy * dy) << 8) - r16;
+  int cov = w8 + 8 - ((d < 0)? -d : d);
+
+  if(cov <= 0)
+    {
+      return 0;
+    }
+  return (cov > AA_LEVELS)? AA_LEVELS : (unsigned int)cov;
+}
+
+/**
+********************************************************************************
+* @function  void _AARingRow(int cxl ,int cxr ,int y ,int h ,int dy ,int r)
+* @brief     Send the rows y ~ y + h - 1 of an anti-aliased round rectangle
+*            outline ,dy rows away from its corner centres.
+*            The pixels between cxl and cxr are at the distance dy from the
+*            outline ,the ones right of cxr (left of cxl) are measured from
+*            the corner centre. A side of a row is ,from the outside :
+*            outer edge ,fully covered ,inner edge ,hole.
+*            Edge pixels of one row are runs ,of several rows one window a
+*            column. Only the pixels in the clip columns are looked at.
+********************************************************************************
+**/
+static void _AARingRow(int cxl ,int cxr ,int y ,int h ,int dy ,int r)
+{
+  int r16 = r << 4, w8 = stroke.width << 3;
+  int a, b, c, e, dx, mid, end;
+  unsigned int cov;
+
+  a = _RingDx(r16 - w8 - 8, dy) + 1;    /* first covered */
+  b = _RingDx(r16 - w8 + 7, dy);        /* last inner edge */
+  c = _RingDx(r16 + w8 - 8, dy);        /* last fully covered */
+  e = _RingDx(r16 + w8 + 7, dy);        /* last covered */
+  if(e < 0)
+    {
+      return;
+    }
+
+  mid = (a == 0 && b < 0 && c >= 0);    /* the middle is fully covered */
+  end = cxl - clip.x1;                  /* smaller dx are right of the clip */
+  for(dx = (e < cxl - clip.x0)? e : cxl - clip.x0; dx >= 1; dx--)
+    {                                   /* left side */
+      if(dx < a || dx < end)
+	{
+	  break;
+	}
+      if(dx <= c && dx > b)
+	{
+	  if(mid != 0)
+	    {
+	      break;
+	    }
+	  _AAFlush();
+	  _FillSpans(cxl - dx, cxl - ((b + 1 > 1)? b + 1 : 1), y, h);
+	  dx = (b + 1 > 1)? b + 1 : 1;
+	  continue;
+	}
+      cov = _RingCov(dx, dy, r16, w8);
+      if(h == 1)
+	{
+	  _AAPut(cxl - dx, y, cov);
+	}
+      else
+	{
+	  _AASpan(cxl - dx, cxl - dx, y, h, cov);
+	}
+    }
+
+  if(mid != 0)
+    {
+      _AAFlush();
+      _FillSpans(cxl - c, cxr + c, y, h);
+      dx = c + 1;
+    }
+  else
+    {
+      if(a == 0)
+	{
+	  cov = _RingCov(0, dy, r16, w8);
+	  if(h == 1 && cxl == cxr)
+	    {
+	      _AAPut(cxl, y, cov);
+	    }
+	  else
+	    {
+	      _AASpan(cxl, cxr, y, h, cov);
+	    }
+	}
+      dx = (a > 1)? a : 1;
+    }
+
+  if(dx < clip.x0 - cxr)                /* smaller dx are left of the clip */
+    {
+      dx = clip.x0 - cxr;
+    }
+  end = (e < clip.x1 - cxr)? e : clip.x1 - cxr;
+  for(; dx <= end; dx++)                /* right side */
+    {
+      if(dx <= c && dx > b)
+	{
+	  _AAFlush();
+	  _FillSpans(cxr + dx, cxr + c, y, h);
+	  dx = c;
+	  continue;
+	}
+      cov = _RingCov(dx, dy, r16, w8);
+      if(h == 1)
+	{
+	  _AAPut(cxr + dx, y, cov);
+	}
+      else
+	{
+	  _AASpan(cxr + dx, cxr + dx, y, h, cov);
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _AARRect(int x0 ,int y0 ,int x1 ,int y1 ,int r)
+* @brief     Draw an anti-aliased round rectangle outline (a circle is
+*            (x-r ,y-r ,x+r ,y+r ,r)) with the stroke width ,solid.
+*            The straight rows between the corner centres are the same ,
+*            they are sent as windows.
+*            Note: x0 <= x1 , y0 <= y1 , (r << 1) <= x1 - x0 , y1 - y0
+********************************************************************************
+**/
+static void _AARRect(int x0 ,int y0 ,int x1 ,int y1 ,int r)
+{
+  int cxl = x0 + r, cxr = x1 - r, cyt = y0 + r, cyb = y1 - r;
+  int reach = (((stroke.width << 3) + 8) >> 4) + 1;
+  int dy, ys, ye;
+
+  if(x0 - reach > clip.x1 || x1 + reach < clip.x0 ||
+     y0 - reach > clip.y1 || y1 + reach < clip.y0)
+    {
+      return;
+    }
+
+  _UpdateAARamp();
+  /* only the corner rows in the clip */
+  ys = (cyt - clip.y0 < r + reach)? cyt - clip.y0 : r + reach;
+  ye = (cyt - clip.y1 > 1)? cyt - clip.y1 : 1;
+  for(dy = ys; dy >= ye; dy--)
+    {
+      _AARingRow(cxl, cxr, cyt - dy, 1, dy, r);
+    }
+
+  ys = (cyt > clip.y0)? cyt : clip.y0;
+  ye = (cyb < clip.y1)? cyb : clip.y1;
+  if(ys <= ye)
+    {
+      _AARingRow(cxl, cxr, ys, ye - ys + 1, 0, r);
+    }
+
+  ys = (clip.y0 - cyb > 1)? clip.y0 - cyb : 1;
+  ye = (clip.y1 - cyb < r + reach)? clip.y1 - cyb : r + reach;
+  for(dy = ys; dy <= ye; dy++)
+    {
+      _AARingRow(cxl, cxr, cyb + dy, 1, dy, r);
+    }
+  _AAFlush();
+}
+
+/**
+********************************************************************************
+* @function  int _StrokeIsThin(void)
+* @brief     Test the stroke style for the 1 pixel solid default.
+* @return    1 --> the default ,the plain draw functions are used
+*            0 --> a width ,a dash pattern or both
+********************************************************************************
+**/
+static int _StrokeIsThin(void)
+{
+  return (stroke.width == 1 && (stroke.dash_on == 0 || stroke.dash_off == 0));
+}
+
+/**
+********************************************************************************
+* @function  int _StrokeArgs(unsigned char **args ,int arg_num ,int *v)
+* @brief     Read 'arg_num' coordinates or radii (see _CoordArgs()) ,and
+*            start the dash pattern again.
+* @return    0  --> succeed
+*            -1 --> a value is out of -CMD_MAX_COORD ~ CMD_MAX_COORD
+********************************************************************************
+**/
+static int _StrokeArgs(unsigned char **args ,int arg_num ,int *v)
+{
+  stroke.phase = 0;
+  return _CoordArgs(args, arg_num, v);
+}
+
+/**
+********************************************************************************
+* @function  void StrokeLine(unsigned char **args ,int arg_num)
+* @brief     AT+dl with the stroke style ,see DrawLine().
+*            Anti-aliased lines are always drawn here.
+********************************************************************************
+**/
+static void StrokeLine(unsigned char **args ,int arg_num)
+{
+  int v[4];
+
+  if(arg_num != 4 || (anti_alias == 0 && _StrokeIsThin()))
+    {
+      DrawLine(args, arg_num);
+      return;
+    }
+  if(_StrokeArgs(args, arg_num, v) != 0)
+    {
+      return;
+    }
+  if(anti_alias != 0)
+    {
+      _AALine(v[0], v[1], v[2], v[3]);
+      return;
+    }
+  _StrokeLine(v[0], v[1], v[2], v[3]);
+}
+
+/**
+********************************************************************************
+* @function  void StrokeRect(unsigned char **args ,int arg_num)
+* @brief     AT+dr with the stroke style ,see DrawRectangle().
+********************************************************************************
+**/
+static void StrokeRect(unsigned char **args ,int arg_num)
+{
+  int v[4], t;
+
+  if(arg_num != 4 || _StrokeIsThin())
+    {
+      DrawRectangle(args, arg_num);
+      return;
+    }
+  if(_StrokeArgs(args, arg_num, v) != 0)
+    {
+      return;
+    }
+  if(v[0] > v[2])
+    {
+      t = v[0];  v[0] = v[2];  v[2] = t;
+    }
+  if(v[1] > v[3])
+    {
+      t = v[1];  v[1] = v[3];  v[3] = t;
+    }
+  _StrokeRect(v[0], v[1], v[2], v[3]);
+}
+
+/**
+********************************************************************************
+* @function  void StrokeCircle(unsigned char **args ,int arg_num)
+* @brief     AT+dc with the stroke style ,see DrawCircle().
+*            Solid circles are anti-aliased when AT+aa is on.
+********************************************************************************
+**/
+static void StrokeCircle(unsigned char **args ,int arg_num)
+{
+  int v[3];
+
+  if(arg_num != 3 || (anti_alias == 0 && _StrokeIsThin()))
+    {
+      DrawCircle(args, arg_num);
+      return;
+    }
+  if(_StrokeArgs(args, arg_num, v) != 0)
+    {
+      return;
+    }
+  if(v[2] < 0)
+    {
+      return;
+    }
+  if(anti_alias != 0 && (stroke.dash_on == 0 || stroke.dash_off == 0))
+    {
+      _AARRect(v[0] - v[2], v[1] - v[2], v[0] + v[2], v[1] + v[2], v[2]);
+      return;
+    }
+  _StrokeRRect(v[0] - v[2], v[1] - v[2], v[0] + v[2], v[1] + v[2], v[2]);
+}
+
+/**
+********************************************************************************
+* @function  void StrokeRoundRect(unsigned char **args ,int arg_num)
+* @brief     AT+dR with the stroke style ,see DrawRoundRect().
+*            Solid round rectangles are anti-aliased when AT+aa is on.
+********************************************************************************
+**/
+static void StrokeRoundRect(unsigned char **args ,int arg_num)
+{
+  int v[5], t, dx, dy;
+
+  if((arg_num != 5 && arg_num != 4) ||
+     (anti_alias == 0 && _StrokeIsThin()))
+    {
+      DrawRoundRect(args, arg_num);
+      return;
+    }
+  if(_StrokeArgs(args, arg_num, v) != 0)
+    {
+      return;
+    }
+  if(v[0] > v[2])
+    {
+      t = v[0];  v[0] = v[2];  v[2] = t;
+    }
+  if(v[1] > v[3])
+    {
+      t = v[1];  v[1] = v[3];  v[3] = t;
+    }
+  dx = v[2] - v[0];
+  dy = v[3] - v[1];
+  if(arg_num == 4)
+    {
+      v[4] = (dx < dy)? (dx >> 2) : (dy >> 2);
+    }
+  else if(v[4] < 0 || (v[4] << 1) > dx || (v[4] << 1) > dy)
+    {
+      return;
+    }
+  if(anti_alias != 0 && (stroke.dash_on == 0 || stroke.dash_off == 0))
+    {
+      _AARRect(v[0], v[1], v[2], v[3], v[4]);
+      return;
+    }
+  _StrokeRRect(v[0], v[1], v[2], v[3], v[4]);
+}
+
+/**
+********************************************************************************
+* @function  void SetStroke(unsigned char **args ,int arg_num)
+* @brief     AT+st=width[,dash_on,dash_off[,cap]]
+*            Set the stroke style of AT+dl ,AT+dr ,AT+dc and AT+dR.
+*            width    --> 1 ~ STROKE_MAX_WIDTH
+*            dash_on , dash_off --> pixels on and off ,0 : solid
+*            cap      --> 0 butt ,1 square ,2 round (thick lines only)
+*            AT+st with no parameter goes back to 1 pixel solid lines.
+********************************************************************************
+**/
+static void SetStroke(unsigned char **args ,int arg_num)
+{
+  int v[4] = {1, 0, 0, STROKE_CAP_BUTT};
+  int count;
+
+  if(arg_num != 0 && arg_num != 1 && arg_num != 3 && arg_num != 4)
+    {
+      return;
+    }
+  for(count = 0; count < arg_num; count++)
+    {
+      v[count] = str_to_int(*(args + count));
+    }
+  if(v[0] < 1 || v[0] > STROKE_MAX_WIDTH || v[1] < 0 || v[2] < 0 ||
+     v[1] > (int)display_x || v[2] > (int)display_x ||
+     v[3] < STROKE_CAP_BUTT || v[3] > STROKE_CAP_ROUND)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Stroke width is 1 ~ %d ,cap is 0 ~ 2.\n",
+			STROKE_MAX_WIDTH);
+	}
+      return;
+    }
+  stroke.width = v[0];
+  stroke.dash_on = v[1];
+  stroke.dash_off = v[2];
+  stroke.cap = (unsigned char)v[3];
+}
+
+/**
+********************************************************************************
+* @function  void SetAntiAlias(unsigned char **args ,int arg_num)
+* @brief     AT+aa=0|1
+*            1 : AT+dl ,AT+dc and AT+dR draw anti-aliased strokes ,blended
+*            into back_color. Dashed circles and round rectangles ,and
+*            AT+dr (no slanted edge) are not changed.
+*            0 : back to plain strokes.
+********************************************************************************
+**/
+static void SetAntiAlias(unsigned char **args ,int arg_num)
+{
+  unsigned int on;
+
+  if(arg_num != 1)
+    {
+      return;
+    }
+  on = str_to_uint(*args);
+  if(on > 1)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Parameter is not '0' or '1'.\n");
+	}
+      return;
+    }
+  anti_alias = (unsigned char)on;
+}
+
+/**
+********************************************************************************
+* @variable chart
+* @brief    Strip chart state.
+*           The chart is a ring of columns : each sample is drawn in the
+*           column 'next' ,which then moves right and wraps to the left
+*           edge ,so the newest sample overwrites the oldest one.
+*           Every column keeps the pixel range (lo ~ hi) drawn in it ,so a
+*           new sample only erases the part of the old trace it does not
+*           cover.
+*           x0 , y0 , x1 , y1 --> the chart area
+*           min , max         --> sample values at the bottom and the top
+*           next              --> the column index of the next sample
+*           last_y            --> the y of the last sample ,the trace joins
+*                                 it to the new one
+*           started           --> 0 : no sample yet
+*           lo[] , hi[]       --> the pixel range of each column ,
+*                                 lo > hi : empty column
+********************************************************************************
+**/
+#define CHART_MAX_COLUMN 240
+
+struct _chart
+{
+  unsigned int x0;
+  unsigned int y0;
+  unsigned int x1;
+  unsigned int y1;
+  unsigned int min;
+  unsigned int max;
+  unsigned int next;
+  unsigned int last_y;
+  unsigned char started;
+  unsigned short lo[CHART_MAX_COLUMN];
+  unsigned short hi[CHART_MAX_COLUMN];
+};
+
+static struct _chart chart;
+
+/**
+********************************************************************************
+* @function  void _ChartRun(unsigned int x ,unsigned int y0 ,unsigned int y1,
+*                           unsigned int color)
+* @brief     Fill the pixels y0 ~ y1 of column x ,nothing when y0 > y1.
+*            The entry mode must be LCD_ENTRY_V.
+********************************************************************************
+**/
+static void _ChartRun(unsigned int x ,unsigned int y0 ,unsigned int y1,
+		      unsigned int color)
+{
+  if(y0 > y1)
+    {
+      return;
+    }
+  SetRun_V(x, y0, y1);
+  lcd_fill_pixels(color, y1 - y0 + 1);
+}
+
+/**
+********************************************************************************
+* @function  void _ChartSample(unsigned int value)
+* @brief     Draw one sample in the next column of the chart.
+*            The new trace segment is a vertical run from the last sample's
+*            y to this sample's y. Only the old pixels of the column above
+*            and below the new run are erased.
+*            The entry mode must be LCD_ENTRY_V.
+********************************************************************************
+**/
+static void _ChartSample(unsigned int value)
+{
+  unsigned int x, y, lo, hi, old_lo, old_hi, i;
+
+  if(value < chart.min)
+    {
+      value = chart.min;
+    }
+  if(value > chart.max)
+    {
+      value = chart.max;
+    }
+  y = chart.y1 - (value - chart.min) * (chart.y1 - chart.y0) /
+    (chart.max - chart.min);
+
+  if(chart.started == 0)
+    {
+      chart.last_y = y;
+      chart.started = 1;
+    }
+  lo = (y < chart.last_y)? y : chart.last_y;
+  hi = (y < chart.last_y)? chart.last_y : y;
+
+  i = chart.next;
+  x = chart.x0 + i;
+  old_lo = chart.lo[i];
+  old_hi = chart.hi[i];
+  if(old_lo <= old_hi && old_lo < lo)    /* old pixels above the new run */
+    {
+      _ChartRun(x, old_lo, (old_hi < lo)? old_hi : lo - 1, back_color);
+    }
+  if(old_lo <= old_hi && old_hi > hi)    /* old pixels below the new run */
+    {
+      _ChartRun(x, (old_lo > hi)? old_lo : hi + 1, old_hi, back_color);
+    }
+  _ChartRun(x, lo, hi, front_color);
+
+  chart.lo[i] = (unsigned short)lo;
+  chart.hi[i] = (unsigned short)hi;
+  chart.last_y = y;
+  chart.next = (i + 1 > chart.x1 - chart.x0)? 0 : i + 1;
+}
+
+/**
+********************************************************************************
+* @function  void SetChart(unsigned char **args ,int arg_num)
+* @brief     Set up the strip chart ,args : x0 ,y0 ,x1 ,y1 [,min ,max]
+*            The area is cleared with back_color ,the trace starts at the
+*            left edge.
+*            min , max --> sample values at the bottom and the top ,
+*                          default 0 , 255
+*            The chart is at most CHART_MAX_COLUMN columns wide.
+********************************************************************************
+**/
+static void SetChart(unsigned char **args ,int arg_num)
+{
+  unsigned int value[6], count, i;
+
+  if(arg_num != 4 && arg_num != 6)
+    {
+      return;
+    }
+
+  for(count = 0; count < (unsigned int)arg_num; count++)
+    {
+      value[count] = str_to_uint(*(args + count));
+    }
+  if(arg_num == 4)
+    {
+      value[4] = 0;
+      value[5] = 255;
+    }
+
+  if(value[0] >= value[2] || value[1] >= value[3] ||
+     value[2] >= display_x || value[3] >= display_y ||
+     value[2] - value[0] >= CHART_MAX_COLUMN || value[4] >= value[5])
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Chart parameters error.\n");
+	}
+      return;
+    }
+
+  chart.x0 = value[0];
+  chart.y0 = value[1];
+  chart.x1 = value[2];
+  chart.y1 = value[3];
+  chart.min = value[4];
+  chart.max = value[5];
+  chart.next = 0;
+  chart.started = 0;
+  for(i = 0; i < CHART_MAX_COLUMN; i++)
+    {
+      chart.lo[i] = 1;
+      chart.hi[i] = 0;
+    }
+
+  _FillWindow(chart.x0, chart.y0, chart.x1, chart.y1, back_color);
+}
+
+/**
+********************************************************************************
+* @function  void ChartData(unsigned char **args ,int arg_num)
+* @brief     Add samples to the strip chart.
+*            Every parameter is a string of samples ,2 hexadecimal digits
+*            each (00 ~ ff) ,for example "AT+cd=10204080ff;".
+*            Each sample moves the chart one column.
+********************************************************************************
+**/
+static void ChartData(unsigned char **args ,int arg_num)
+{
+  unsigned char *p;
+  unsigned int value, digit, half;
+  int count;
+
+  if(chart.x1 == 0)    /* no chart set up */
+    {
+      return;
+    }
+
+  SetEntry(LCD_ENTRY_V);
+  for(count = 0; count < arg_num; count++)
+    {
+      value = 0;
+      half = 0;
+      for(p = *(args + count); *p != '\0'; p++)
+	{
+	  if(*p >= '0' && *p <= '9')
+	    {
+	      digit = *p - '0';
+	    }
+	  else if(*p >= 'a' && *p <= 'f')
+	    {
+	      digit = *p - 'a' + 10;
+	    }
+	  else if(*p >= 'A' && *p <= 'F')
+	    {
+	      digit = *p - 'A' + 10;
+	    }
+	  else
+	    {
+	      continue;
+	    }
+	  value = (value << 4) | digit;
+	  if(++half == 2)
+	    {
+	      _ChartSample(value);
+	      value = 0;
+	      half = 0;
+	    }
+	}
+    }
+  SetEntry(LCD_ENTRY_H);
+}
+
+/**
+********************************************************************************
+* @variable glyph_lut , lut_front , lut_back , lut_valid
+* @brief    Glyph expansion table.
+*           glyph_lut[n] holds the 4 pixels of the font bits nibble 'n'
+*           (bit 3 is the left pixel) as two words ,ready for 32 bit stores :
+*           word 0 = pixel 0 | pixel 1 << 16 , word 1 = pixel 2 | pixel 3 << 16
+*           A set bit is front_color ,a clear bit is back_color.
+*           The table is rebuilt only when one of the two colors changed.
+********************************************************************************
+**/
+static uint32_t glyph_lut[16][2];
+static unsigned int lut_front = 0, lut_back = 0;
+static unsigned char lut_valid = 0;
+
+/**
+********************************************************************************
+* @variable text_mode , byte_runs
+* @brief    Transparent text support.
+*           text_mode    --> TEXT_OPAQUE : the glyph cell is filled ,clear bits
+*                                          in back_color
+*                            TEXT_TRANSPARENT : only the set bits are drawn
+*           byte_runs[n] --> the runs of set bits in the font byte 'n' ,
+*                            byte_runs[n][0] is the runs' number (0~4) ,
+*                            byte_runs[n][1~4] is (start << 4) | length ,
+*                            start 0 is the left pixel (bit 7).
+*           With the table ,a glyph row is turned into runs one byte at a
+*           time ,and runs touching at a byte border are joined.
+*           The table is constant ,so it stays in flash.
+********************************************************************************
+**/
+#define TEXT_OPAQUE      0
+#define TEXT_TRANSPARENT 1
+
+static unsigned char text_mode = TEXT_OPAQUE;
+
+static const unsigned char byte_runs[256][5] =
+  {
+    {0, 0, 0, 0, 0}, {1, 0x71, 0, 0, 0}, /* 0x00 */
+    {1, 0x61, 0, 0, 0}, {1, 0x62, 0, 0, 0}, /* 0x02 */
+    {1, 0x51, 0, 0, 0}, {2, 0x51, 0x71, 0, 0}, /* 0x04 */
+    {1, 0x52, 0, 0, 0}, {1, 0x53, 0, 0, 0}, /* 0x06 */
+    {1, 0x41, 0, 0, 0}, {2, 0x41, 0x71, 0, 0}, /* 0x08 */
+    {2, 0x41, 0x61, 0, 0}, {2, 0x41, 0x62, 0, 0}, /* 0x0a */
+    {1, 0x42, 0, 0, 0}, {2, 0x42, 0x71, 0, 0}, /* 0x0c */
+    {1, 0x43, 0, 0, 0}, {1, 0x44, 0, 0, 0}, /* 0x0e */
+    {1, 0x31, 0, 0, 0}, {2, 0x31, 0x71, 0, 0}, /* 0x10 */
+    {2, 0x31, 0x61, 0, 0}, {2, 0x31, 0x62, 0, 0}, /* 0x12 */
+    {2, 0x31, 0x51, 0, 0}, {3, 0x31, 0x51, 0x71, 0}, /* 0x14 */
+    {2, 0x31, 0x52, 0, 0}, {2, 0x31, 0x53, 0, 0}, /* 0x16 */
+    {1, 0x32, 0, 0, 0}, {2, 0x32, 0x71, 0, 0}, /* 0x18 */
+    {2, 0x32, 0x61, 0, 0}, {2, 0x32, 0x62, 0, 0}, /* 0x1a */
+    {1, 0x33, 0, 0, 0}, {2, 0x33, 0x71, 0, 0}, /* 0x1c */
+    {1, 0x34, 0, 0, 0}, {1, 0x35, 0, 0, 0}, /* 0x1e */
+    {1, 0x21, 0, 0, 0}, {2, 0x21, 0x71, 0, 0}, /* 0x20 */
+    {2, 0x21, 0x61, 0, 0}, {2, 0x21, 0x62, 0, 0}, /* 0x22 */
+    {2, 0x21, 0x51, 0, 0}, {3, 0x21, 0x51, 0x71, 0}, /* 0x24 */
+    {2, 0x21, 0x52, 0, 0}, {2, 0x21, 0x53, 0, 0}, /* 0x26 */
+    {2, 0x21, 0x41, 0, 0}, {3, 0x21, 0x41, 0x71, 0}, /* 0x28 */
+    {3, 0x21, 0x41, 0x61, 0}, {3, 0x21, 0x41, 0x62, 0}, /* 0x2a */
+    {2, 0x21, 0x42, 0, 0}, {3, 0x21, 0x42, 0x71, 0}, /* 0x2c */
+    {2, 0x21, 0x43, 0, 0}, {2, 0x21, 0x44, 0, 0}, /* 0x2e */
+    {1, 0x22, 0, 0, 0}, {2, 0x22, 0x71, 0, 0}, /* 0x30 */
+    {2, 0x22, 0x61, 0, 0}, {2, 0x22, 0x62, 0, 0}, /* 0x32 */
+    {2, 0x22, 0x51, 0, 0}, {3, 0x22, 0x51, 0x71, 0}, /* 0x34 */
+    {2, 0x22, 0x52, 0, 0}, {2, 0x22, 0x53, 0, 0}, /* 0x36 */
+    {1, 0x23, 0, 0, 0}, {2, 0x23, 0x71, 0, 0}, /* 0x38 */
+    {2, 0x23, 0x61, 0, 0}, {2, 0x23, 0x62, 0, 0}, /* 0x3a */
+    {1, 0x24, 0, 0, 0}, {2, 0x24, 0x71, 0, 0}, /* 0x3c */
+    {1, 0x25, 0, 0, 0}, {1, 0x26, 0, 0, 0}, /* 0x3e */
+    {1, 0x11, 0, 0, 0}, {2, 0x11, 0x71, 0, 0}, /* 0x40 */
+    {2, 0x11, 0x61, 0, 0}, {2, 0x11, 0x62, 0, 0}, /* 0x42 */
+    {2, 0x11, 0x51, 0, 0}, {3, 0x11, 0x51, 0x71, 0}, /* 0x44 */
+    {2, 0x11, 0x52, 0, 0}, {2, 0x11, 0x53, 0, 0}, /* 0x46 */
+    {2, 0x11, 0x41, 0, 0}, {3, 0x11, 0x41, 0x71, 0}, /* 0x48 */
+    {3, 0x11, 0x41, 0x61, 0}, {3, 0x11, 0x41, 0x62, 0}, /* 0x4a */
+    {2, 0x11, 0x42, 0, 0}, {3, 0x11, 0x42, 0x71, 0}, /* 0x4c */
+    {2, 0x11, 0x43, 0, 0}, {2, 0x11, 0x44, 0, 0}, /* 0x4e */
+    {2, 0x11, 0x31, 0, 0}, {3, 0x11, 0x31, 0x71, 0}, /* 0x50 */
+    {3, 0x11, 0x31, 0x61, 0}, {3, 0x11, 0x31, 0x62, 0}, /* 0x52 */
+    {3, 0x11, 0x31, 0x51, 0}, {4, 0x11, 0x31, 0x51, 0x71}, /* 0x54 */
+    {3, 0x11, 0x31, 0x52, 0}, {3, 0x11, 0x31, 0x53, 0}, /* 0x56 */
+    {2, 0x11, 0x32, 0, 0}, {3, 0x11, 0x32, 0x71, 0}, /* 0x58 */
+    {3, 0x11, 0x32, 0x61, 0}, {3, 0x11, 0x32, 0x62, 0}, /* 0x5a */
+    {2, 0x11, 0x33, 0, 0}, {3, 0x11, 0x33, 0x71, 0}, /* 0x5c */
+    {2, 0x11, 0x34, 0, 0}, {2, 0x11, 0x35, 0, 0}, /* 0x5e */
+    {1, 0x12, 0, 0, 0}, {2, 0x12, 0x71, 0, 0}, /* 0x60 */
+    {2, 0x12, 0x61, 0, 0}, {2, 0x12, 0x62, 0, 0}, /* 0x62 */
+    {2, 0x12, 0x51, 0, 0}, {3, 0x12, 0x51, 0x71, 0}, /* 0x64 */
+    {2, 0x12, 0x52, 0, 0}, {2, 0x12, 0x53, 0, 0}, /* 0x66 */
+    {2, 0x12, 0x41, 0, 0}, {3, 0x12, 0x41, 0x71, 0}, /* 0x68 */
+    {3, 0x12, 0x41, 0x61, 0}, {3, 0x12, 0x41, 0x62, 0}, /* 0x6a */
+    {2, 0x12, 0x42, 0, 0}, {3, 0x12, 0x42, 0x71, 0}, /* 0x6c */
+    {2, 0x12, 0x43, 0, 0}, {2, 0x12, 0x44, 0, 0}, /* 0x6e */
+    {1, 0x13, 0, 0, 0}, {2, 0x13, 0x71, 0, 0}, /* 0x70 */
+    {2, 0x13, 0x61, 0, 0}, {2, 0x13, 0x62, 0, 0}, /* 0x72 */
+    {2, 0x13, 0x51, 0, 0}, {3, 0x13, 0x51, 0x71, 0}, /* 0x74 */
+    {2, 0x13, 0x52, 0, 0}, {2, 0x13, 0x53, 0, 0}, /* 0x76 */
+    {1, 0x14, 0, 0, 0}, {2, 0x14, 0x71, 0, 0}, /* 0x78 */
+    {2, 0x14, 0x61, 0, 0}, {2, 0x14, 0x62, 0, 0}, /* 0x7a */
+    {1, 0x15, 0, 0, 0}, {2, 0x15, 0x71, 0, 0}, /* 0x7c */
+    {1, 0x16, 0, 0, 0}, {1, 0x17, 0, 0, 0}, /* 0x7e */
+    {1, 0x01, 0, 0, 0}, {2, 0x01, 0x71, 0, 0}, /* 0x80 */
+    {2, 0x01, 0x61, 0, 0}, {2, 0x01, 0x62, 0, 0}, /* 0x82 */
+    {2, 0x01, 0x51, 0, 0}, {3, 0x01, 0x51, 0x71, 0}, /* 0x84 */
+    {2, 0x01, 0x52, 0, 0}, {2, 0x01, 0x53, 0, 0}, /* 0x86 */
+    {2, 0x01, 0x41, 0, 0}, {3, 0x01, 0x41, 0x71, 0}, /* 0x88 */
+    {3, 0x01, 0x41, 0x61, 0}, {3, 0x01, 0x41, 0x62, 0}, /* 0x8a */
+    {2, 0x01, 0x42, 0, 0}, {3, 0x01, 0x42, 0x71, 0}, /* 0x8c */
+    {2, 0x01, 0x43, 0, 0}, {2, 0x01, 0x44, 0, 0}, /* 0x8e */
+    {2, 0x01, 0x31, 0, 0}, {3, 0x01, 0x31, 0x71, 0}, /* 0x90 */
+    {3, 0x01, 0x31, 0x61, 0}, {3, 0x01, 0x31, 0x62, 0}, /* 0x92 */
+    {3, 0x01, 0x31, 0x51, 0}, {4, 0x01, 0x31, 0x51, 0x71}, /* 0x94 */
+    {3, 0x01, 0x31, 0x52, 0}, {3, 0x01, 0x31, 0x53, 0}, /* 0x96 */
+    {2, 0x01, 0x32, 0, 0}, {3, 0x01, 0x32, 0x71, 0}, /* 0x98 */
+    {3, 0x01, 0x32, 0x61, 0}, {3, 0x01, 0x32, 0x62, 0}, /* 0x9a */
+    {2, 0x01, 0x33, 0, 0}, {3, 0x01, 0x33, 0x71, 0}, /* 0x9c */
+    {2, 0x01, 0x34, 0, 0}, {2, 0x01, 0x35, 0, 0}, /* 0x9e */
+    {2, 0x01, 0x21, 0, 0}, {3, 0x01, 0x21, 0x71, 0}, /* 0xa0 */
+    {3, 0x01, 0x21, 0x61, 0}, {3, 0x01, 0x21, 0x62, 0}, /* 0xa2 */
+    {3, 0x01, 0x21, 0x51, 0}, {4, 0x01, 0x21, 0x51, 0x71}, /* 0xa4 */
+    {3, 0x01, 0x21, 0x52, 0}, {3, 0x01, 0x21, 0x53, 0}, /* 0xa6 */
+    {3, 0x01, 0x21, 0x41, 0}, {4, 0x01, 0x21, 0x41, 0x71}, /* 0xa8 */
+    {4, 0x01, 0x21, 0x41, 0x61}, {4, 0x01, 0x21, 0x41, 0x62}, /* 0xaa */
+    {3, 0x01, 0x21, 0x42, 0}, {4, 0x01, 0x21, 0x42, 0x71}, /* 0xac */
+    {3, 0x01, 0x21, 0x43, 0}, {3, 0x01, 0x21, 0x44, 0}, /* 0xae */
+    {2, 0x01, 0x22, 0, 0}, {3, 0x01, 0x22, 0x71, 0}, /* 0xb0 */
+    {3, 0x01, 0x22, 0x61, 0}, {3, 0x01, 0x22, 0x62, 0}, /* 0xb2 */
+    {3, 0x01, 0x22, 0x51, 0}, {4, 0x01, 0x22, 0x51, 0x71}, /* 0xb4 */
+    {3, 0x01, 0x22, 0x52, 0}, {3, 0x01, 0x22, 0x53, 0}, /* 0xb6 */
+    {2, 0x01, 0x23, 0, 0}, {3, 0x01, 0x23, 0x71, 0}, /* 0xb8 */
+    {3, 0x01, 0x23, 0x61, 0}, {3, 0x01, 0x23, 0x62, 0}, /* 0xba */
+    {2, 0x01, 0x24, 0, 0}, {3, 0x01, 0x24, 0x71, 0}, /* 0xbc */
+    {2, 0x01, 0x25, 0, 0}, {2, 0x01, 0x26, 0, 0}, /* 0xbe */
+    {1, 0x02, 0, 0, 0}, {2, 0x02, 0x71, 0, 0}, /* 0xc0 */
+    {2, 0x02, 0x61, 0, 0}, {2, 0x02, 0x62, 0, 0}, /* 0xc2 */
+    {2, 0x02, 0x51, 0, 0}, {3, 0x02, 0x51, 0x71, 0}, /* 0xc4 */
+    {2, 0x02, 0x52, 0, 0}, {2, 0x02, 0x53, 0, 0}, /* 0xc6 */
+    {2, 0x02, 0x41, 0, 0}, {3, 0x02, 0x41, 0x71, 0}, /* 0xc8 */
+    {3, 0x02, 0x41, 0x61, 0}, {3, 0x02, 0x41, 0x62, 0}, /* 0xca */
+    {2, 0x02, 0x42, 0, 0}, {3, 0x02, 0x42, 0x71, 0}, /* 0xcc */
+    {2, 0x02, 0x43, 0, 0}, {2, 0x02, 0x44, 0, 0}, /* 0xce */
+    {2, 0x02, 0x31, 0, 0}, {3, 0x02, 0x31, 0x71, 0}, /* 0xd0 */
+    {3, 0x02, 0x31, 0x61, 0}, {3, 0x02, 0x31, 0x62, 0}, /* 0xd2 */
+    {3, 0x02, 0x31, 0x51, 0}, {4, 0x02, 0x31, 0x51, 0x71}, /* 0xd4 */
+    {3, 0x02, 0x31, 0x52, 0}, {3, 0x02, 0x31, 0x53, 0}, /* 0xd6 */
+    {2, 0x02, 0x32, 0, 0}, {3, 0x02, 0x32, 0x71, 0}, /* 0xd8 */
+    {3, 0x02, 0x32, 0x61, 0}, {3, 0x02, 0x32, 0x62, 0}, /* 0xda */
+    {2, 0x02, 0x33, 0, 0}, {3, 0x02, 0x33, 0x71, 0}, /* 0xdc */
+    {2, 0x02, 0x34, 0, 0}, {2, 0x02, 0x35, 0, 0}, /* 0xde */
+    {1, 0x03, 0, 0, 0}, {2, 0x03, 0x71, 0, 0}, /* 0xe0 */
+    {2, 0x03, 0x61, 0, 0}, {2, 0x03, 0x62, 0, 0}, /* 0xe2 */
+    {2, 0x03, 0x51, 0, 0}, {3, 0x03, 0x51, 0x71, 0}, /* 0xe4 */
+    {2, 0x03, 0x52, 0, 0}, {2, 0x03, 0x53, 0, 0}, /* 0xe6 */
+    {2, 0x03, 0x41, 0, 0}, {3, 0x03, 0x41, 0x71, 0}, /* 0xe8 */
+    {3, 0x03, 0x41, 0x61, 0}, {3, 0x03, 0x41, 0x62, 0}, /* 0xea */
+    {2, 0x03, 0x42, 0, 0}, {3, 0x03, 0x42, 0x71, 0}, /* 0xec */
+    {2, 0x03, 0x43, 0, 0}, {2, 0x03, 0x44, 0, 0}, /* 0xee */
+    {1, 0x04, 0, 0, 0}, {2, 0x04, 0x71, 0, 0}, /* 0xf0 */
+    {2, 0x04, 0x61, 0, 0}, {2, 0x04, 0x62, 0, 0}, /* 0xf2 */
+    {2, 0x04, 0x51, 0, 0}, {3, 0x04, 0x51, 0x71, 0}, /* 0xf4 */
+    {2, 0x04, 0x52, 0, 0}, {2, 0x04, 0x53, 0, 0}, /* 0xf6 */
+    {1, 0x05, 0, 0, 0}, {2, 0x05, 0x71, 0, 0}, /* 0xf8 */
+    {2, 0x05, 0x61, 0, 0}, {2, 0x05, 0x62, 0, 0}, /* 0xfa */
+    {1, 0x06, 0, 0, 0}, {2, 0x06, 0x71, 0, 0}, /* 0xfc */
+    {1, 0x07, 0, 0, 0}, {1, 0x08, 0, 0, 0}  /* 0xfe */
+  };
+
+/**
+********************************************************************************
+* @function  void _UpdateGlyphLUT(void)
+* @brief     Rebuild glyph_lut[] if front_color or back_color changed.
+********************************************************************************
+**/
+static void _UpdateGlyphLUT(void)
+{
+  unsigned int n, i;
+  uint32_t pixel[4];
+
+  if(lut_valid != 0 && lut_front == front_color && lut_back == back_color)
+    {
+      return;
+    }
+
+  for(n = 0; n < 16; n++)
+    {
+      for(i = 0; i < 4; i++)
+	{
+	  pixel[i] = ((n & (0x08 >> i)) != 0)? front_color : back_color;
+	  pixel[i] &= 0xffff;
+	}
+      glyph_lut[n][0] = pixel[0] | (pixel[1] << 16);
+      glyph_lut[n][1] = pixel[2] | (pixel[3] << 16);
+    }
+
+  lut_front = front_color;
+  lut_back = back_color;
+  lut_valid = 1;
+}
+
+/**
+********************************************************************************
+* @function  void _ExpandGlyph(const unsigned char *bits ,unsigned int nbytes,
+*                              uint32_t *dst)
+* @brief     Expand 'nbytes' font bytes to 8 * nbytes pixels in 'dst'
+*            (2 pixels per word ,4 words per font byte).
+*            Word aligned font data is read a word at a time ,every nibble
+*            is one table lookup and two word copies.
+*            _UpdateGlyphLUT() must have been called.
+********************************************************************************
+**/
+static void _ExpandGlyph(const unsigned char *bits ,unsigned int nbytes,
+			 uint32_t *dst)
+{
+  uint32_t word;
+  unsigned int i, ch;
+  const uint32_t *lut;
+
+  while(nbytes >= 4 && ((uint32_t)bits & 0x03) == 0)
+    {
+      word = *(const uint32_t *)bits;  /* the first font byte is the low byte */
+      for(i = 0; i < 4; i++)
+	{
+	  ch = word & 0xff;
+	  word >>= 8;
+	  lut = glyph_lut[ch >> 4];
+	  *dst++ = lut[0];
+	  *dst++ = lut[1];
+	  lut = glyph_lut[ch & 0x0f];
+	  *dst++ = lut[0];
+	  *dst++ = lut[1];
+	}
+      bits += 4;
+      nbytes -= 4;
+    }
+
+  while(nbytes != 0)
+    {
+      ch = *bits++;
+      lut = glyph_lut[ch >> 4];
+      *dst++ = lut[0];
+      *dst++ = lut[1];
+      lut = glyph_lut[ch & 0x0f];
+      *dst++ = lut[0];
+      *dst++ = lut[1];
+      nbytes--;
+    }
+}
+
+/**
+********************************************************************************
+* @function  const unsigned char *_GlyphBits(unsigned char c)
+* @brief     Get the font data of character 'c' in the current font.
+* @return    pointer to the first font byte of 'c'
+*            0 --> 'c' is not in the current font
+********************************************************************************
+**/
+static const unsigned char *_GlyphBits(unsigned char c)
+{
+  if(c < cfont.offset || c >= cfont.offset + cfont.numchars)
+    {
+      return (const unsigned char *)0;
+    }
+  return cfont.font + 4 + (c - cfont.offset) * ((cfont.x_size/8)*cfont.y_size);
+}
+
+/**
+********************************************************************************
+* @function  void _print_char_runs(unsigned int x ,unsigned int y,
+*                                  const unsigned char *bits)
+* @brief     Draw only the set bits of a glyph in front_color.
+*            Every row is sent as runs ,the pixels under the clear bits are
+*            left as they are.
+********************************************************************************
+**/
+static void _print_char_runs(unsigned int x ,unsigned int y,
+			     const unsigned char *bits)
+{
+  unsigned int row, b, k, row_bytes;
+  unsigned int start, end, run_start, run_end;
+  const unsigned char *runs;
+
+  row_bytes = cfont.x_size / 8;
+  for(row = 0; row < cfont.y_size; row++)
+    {
+      run_start = 0;
+      run_end = 0;
+      for(b = 0; b < row_bytes; b++)
+	{
+	  runs = byte_runs[*bits++];
+	  for(k = 1; k <= runs[0]; k++)
+	    {
+	      start = (b << 3) + (runs[k] >> 4);
+	      end = start + (runs[k] & 0x0f);
+	      if(run_end != 0 && start == run_end)
+		{
+		  run_end = end;      /* join the run of the last byte */
+		  continue;
+		}
+	      if(run_end != 0)
+		{
+		  SetSpan(x + run_start, x + run_end - 1, y + row);
+		  lcd_fill_pixels(front_color, run_end - run_start);
+		}
+	      run_start = start;
+	      run_end = end;
+	    }
+	}
+      if(run_end != 0)
+	{
+	  SetSpan(x + run_start, x + run_end - 1, y + row);
+	  lcd_fill_pixels(front_color, run_end - run_start);
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _print_char_clip(int x ,int y ,const unsigned char *bits)
+* @brief     print the part of a glyph in the clip rectangle.
+*            Only for the cells cut by the clip rectangle ,every visible row
+*            is built bit by bit : opaque rows are sent as one burst ,
+*            transparent rows as runs of the set bits.
+*            'bits' 0 is a blank cell.
+********************************************************************************
+**/
+static void _print_char_clip(int x ,int y ,const unsigned char *bits)
+{
+  int x0 = x, y0 = y;
+  int x1 = x + cfont.x_size - 1, y1 = y + cfont.y_size - 1;
+  int row, col, run_start;
+  unsigned int row_bytes, set;
+  const unsigned char *p;
+  uint16_t *dst = (uint16_t *)line_buf;
+
+  if(_ClipRect(&x0, &y0, &x1, &y1) != 0)
+    {
+      return;
+    }
+  if(bits == 0)
+    {
+      if(text_mode != TEXT_TRANSPARENT)
+	{
+	  _FillWindow(x0, y0, x1, y1, back_color);
+	}
+      return;
+    }
+
+  row_bytes = cfont.x_size / 8;
+  for(row = y0; row <= y1; row++)
+    {
+      p = bits + (row - y) * row_bytes;
+      run_start = -1;
+      for(col = x0; col <= x1 + 1; col++)
+	{
+	  set = 0;
+	  if(col <= x1)
+	    {
+	      set = p[(col - x) >> 3] & (0x80 >> ((col - x) & 0x07));
+	    }
+	  if(text_mode != TEXT_TRANSPARENT)
+	    {
+	      if(col <= x1)
+		{
+		  dst[col - x0] = (uint16_t)((set != 0)? front_color : back_color);
+		}
+	    }
+	  else if(set != 0 && run_start < 0)
+	    {
+	      run_start = col;
+	    }
+	  else if(set == 0 && run_start >= 0)
+	    {
+	      SetSpan(run_start, col - 1, row);
+	      lcd_fill_pixels(front_color, col - run_start);
+	      run_start = -1;
+	    }
+	}
+      if(text_mode != TEXT_TRANSPARENT)
+	{
+	  SetSpan(x0, x1, row);
+	  lcd_write_pixels(dst, x1 - x0 + 1);
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  _print_char(int x ,int y ,unsigned char c)
+* @brief     print a character on LCD.
+*            The glyph is expanded 4 font bytes (32 pixels) at a time and
+*            sent in bursts. A character not in the font is a blank cell.
+*            In TEXT_TRANSPARENT mode only the set bits are drawn.
+*            A cell cut by the clip rectangle goes to _print_char_clip().
+********************************************************************************
+**/
+static void _print_char(int x ,int y ,unsigned char c)
+{
+  const unsigned char *bits;
+  unsigned int nbytes, count;
+  uint32_t pixels[16];
+
+  bits = _GlyphBits(c);
+  if(!_ClipInside(x, y, x + cfont.x_size - 1, y + cfont.y_size - 1))
+    {
+      _print_char_clip(x, y, bits);
+      return;
+    }
+  if(text_mode == TEXT_TRANSPARENT)
+    {
+      if(bits != 0)
+	{
+	  _print_char_runs(x, y, bits);
+	}
+      return;
+    }
+  if(bits == 0)
+    {
+      _FillWindow(x, y, x + cfont.x_size - 1, y + cfont.y_size - 1,
+		  back_color);
+      return;
+    }
+
+  _UpdateGlyphLUT();
+  SetXY(x, y, x + cfont.x_size - 1, y + cfont.y_size - 1);
+
+  nbytes = (cfont.x_size/8)*cfont.y_size;
+  while(nbytes != 0)
+    {
+      count = (nbytes > 4)? 4 : nbytes;
+      _ExpandGlyph(bits, count, pixels);
+      lcd_write_pixels((const uint16_t *)pixels, count << 3);
+      bits += count;
+      nbytes -= count;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _print_glyphs(unsigned int x ,unsigned int y,
+*                               const unsigned char **bits ,unsigned int n)
+* @brief     print 'n' glyphs on one text line.
+*            'bits' are the glyphs' font data (_GlyphBits()) ,0 is a blank
+*            cell.
+*            Opaque text uses a single window covering all the glyphs ,every
+*            scanline is built from the same row of all the glyphs and sent
+*            in one burst.
+*            The caller makes sure the text fits in the screen and in
+*            line_buf.
+********************************************************************************
+**/
+static void _print_glyphs(unsigned int x ,unsigned int y,
+			  const unsigned char **bits ,unsigned int n)
+{
+  unsigned int row_bytes, row, i, j, offset;
+  uint32_t *dst;
+
+  if(text_mode == TEXT_TRANSPARENT)
+    {
+      for(i = 0; i < n; i++)
+	{
+	  if(bits[i] != 0)
+	    {
+	      _print_char_runs(x + i * cfont.x_size, y, bits[i]);
+	    }
+	}
+      return;
+    }
+
+  row_bytes = cfont.x_size / 8;
+  _UpdateGlyphLUT();
+  SetXY(x, y, x + n * cfont.x_size - 1, y + cfont.y_size - 1);
+
+  for(row = 0, offset = 0; row < cfont.y_size; row++, offset += row_bytes)
+    {
+      dst = line_buf;
+      for(i = 0; i < n; i++)
+	{
+	  if(bits[i] != 0)
+	    {
+	      _ExpandGlyph(bits[i] + offset, row_bytes, dst);
+	    }
+	  else
+	    {
+	      for(j = 0; j < (row_bytes << 2); j++)
+		{
+		  dst[j] = glyph_lut[0][0];    /* blank */
+		}
+	    }
+	  dst += row_bytes << 2;
+	}
+      lcd_write_pixels((const uint16_t *)line_buf, n * cfont.x_size);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _print_line(unsigned int x ,unsigned int y,
+*                             const unsigned char *str ,unsigned int n)
+* @brief     print 'n' characters on one text line with _print_glyphs().
+*            The caller makes sure the text fits in the screen and in
+*            line_buf.
+********************************************************************************
+**/
+static void _print_line(unsigned int x ,unsigned int y,
+			const unsigned char *str ,unsigned int n)
+{
+  const unsigned char *bits[LCD_LINE_WORDS / 4];
+  unsigned int i;
+
+  for(i = 0; i < n; i++)
+    {
+      bits[i] = _GlyphBits(str[i]);
+    }
+  _print_glyphs(x, y, bits, n);
+}
+
+/**
+********************************************************************************
+* @function  int _FrameAddText(unsigned int x ,unsigned int y,
+*                              const unsigned char *str ,unsigned int n)
+* @brief     Put 'n' characters on one text line in the frame display list.
+* @return    0  --> the text is in the list
+*            -1 --> no frame or the list is full ,draw it now
+********************************************************************************
+**/
+static int _FrameAddText(unsigned int x ,unsigned int y,
+			 const unsigned char *str ,unsigned int n)
+{
+  if(frame.text + n > FRAME_MAX_TEXT ||
+     _FrameAdd(FRAME_TEXT, x, y, x + n * cfont.x_size - 1,
+	       y + cfont.y_size - 1, frame.text, front_color) != 0)
+    {
+      return -1;
+    }
+
+  frame_op[frame.count - 1].len = (unsigned short)n;
+  frame_op[frame.count - 1].mode = text_mode;
+  memcpy(&frame_text[frame.text], str, n);
+  frame.text += n;
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  void PrintString(unsigned char **args, int arg_num)
+* @brief     print a string on LCD.
+*            The string may start left of or above the screen ,the cells
+*            out of the clip rectangle are cut.
+********************************************************************************
+**/
+static void PrintString(unsigned char **args, int arg_num)
+{
+  int location[2] ,right ,bottom;
+  unsigned int count ,n;
+  unsigned char *str;
+  if(arg_num != 3)
+    {
+      return;      
+    }
+
+  for(count = 0 ;count < 2; count++)
+    {
+      location[count] = str_to_int(*(args + count));
+    }
+
+  right = (int)(display_x - cfont.x_size);
+  bottom = (int)(display_y - cfont.y_size);
+  if(location[0] >= right || location[1] >= bottom)
+    {
+      return;
+    }
+
+  str = *(args + 2);
+
+  /* In a frame ,every text line goes to the display list */
+  count = strlen((const char *)str);
+  while(frame.active != 0 && count != 0)
+    {
+      n = 1;
+      while(n < count &&
+	    location[0] + (int)(n * cfont.x_size) < right)
+	{
+	  n++;
+	}
+      /* a line cut by the clip rectangle is drawn now */
+      if(!_ClipInside(location[0], location[1],
+		      location[0] + (int)(n * cfont.x_size) - 1,
+		      location[1] + (int)cfont.y_size - 1) ||
+	 _FrameAddText(location[0] ,location[1] ,str ,n) != 0)
+	{
+	  break;    /* the list is full ,draw the rest now */
+	}
+      str += n;
+      count -= n;
+      if(location[0] + (int)(n * cfont.x_size) >= right)
+	{
+	  location[0] = 0;
+	  location[1] += cfont.y_size;
+	  if(location[1] >= bottom)
+	    {
+	      return;
+	    }
+	}
+    }
+
+  /* Text that fits on one line is drawn row by row in one window */
+  if(text_mode == TEXT_OPAQUE && count != 0 &&
+     count * cfont.x_size <= LCD_LINE_WORDS * 2 &&
+     _ClipInside(location[0], location[1],
+		 location[0] + (int)(count * cfont.x_size) - 1,
+		 location[1] + (int)cfont.y_size - 1))
+    {
+      _print_line(location[0] ,location[1] ,str ,count);
+      return;
+    }
+
+  while(*str != '\0')
+    {
+      _print_char(location[0] ,location[1] , *str);
+      location[0] += cfont.x_size;
+
+      if(location[0] >= right)
+	{
+	  location[0] = 0;
+	  location[1] += cfont.y_size;
+	}
+      if(location[1] >= bottom) 
+	{
+	  return ;
+	}
+
+      str++;
+    }
+}
+
+
+/**
+********************************************************************************
+* @function  int str_to_number(unsigned char *str ,unsigned int decimals,
+*                              unsigned long *mag ,unsigned char *negative)
+* @brief     Change a number string to a fixed-point value with 'decimals'
+*            decimal places ,'*mag' is the absolute value * 10^decimals.
+*            "[-]123.45"  --> decimal ,the fraction is rounded to 'decimals'
+*            "[-]0x7b"    --> hexadecimal ,already scaled by 10^decimals
+*            "[-]0b1111"  --> binary ,already scaled by 10^decimals
+*            For example ,decimals = 2 : "1.5" --> 150 , "0x96" --> 150
+* @return    0  --> succeed
+*            -1 --> not a number or too big for 32 bits
+********************************************************************************
+**/
+static int str_to_number(unsigned char *str ,unsigned int decimals,
+			 unsigned long *mag ,unsigned char *negative)
+{
+  unsigned long num, digit, base;
+  unsigned int places;
+  unsigned char *p;
+
+  p = str;
+  while(*p == ' ')
+    {
+      p++;
+    }
+  *negative = 0;
+  if(*p == '-')
+    {
+      *negative = 1;
+      p++;
+    }
+
+  base = 10;
+  if(p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    {
+      base = 16;
+      p += 2;
+    }
+  else if(p[0] == '0' && (p[1] == 'b' || p[1] == 'B'))
+    {
+      base = 2;
+      p += 2;
+    }
+
+  num = 0;
+  places = 0;
+  if(*p == '\0')
+    {
+      return -1;
+    }
+  while(*p != '\0')
+    {
+      if(*p >= '0' && *p <= '9')
+	{
+	  digit = *p - '0';
+	}
+      else if(base == 16 && *p >= 'a' && *p <= 'f')
+	{
+	  digit = *p - 'a' + 10;
+	}
+      else if(base == 16 && *p >= 'A' && *p <= 'F')
+	{
+	  digit = *p - 'A' + 10;
+	}
+      else if(base == 10 && *p == '.' && places == 0)
+	{
+	  places = 1;          /* the fraction starts */
+	  p++;
+	  continue;
+	}
+      else
+	{
+	  return -1;
+	}
+      if(digit >= base)
+	{
+	  return -1;
+	}
+
+      if(places > decimals)    /* beyond the decimal places ,round */
+	{
+	  if(places == decimals + 1 && digit >= 5)
+	    {
+	      if(num == 0xffffffffUL)
+		{
+		  return -1;
+		}
+	      num++;
+	    }
+	  places++;
+	  p++;
+	  continue;
+	}
+      if(num > (0xffffffffUL - digit) / base)
+	{
+	  return -1;
+	}
+      num = num * base + digit;
+      if(places != 0)
+	{
+	  places++;
+	}
+      p++;
+    }
+
+  /* scale a decimal number up to 'decimals' places */
+  if(base == 10)
+    {
+      places = (places == 0)? 0 : places - 1;
+      while(places < decimals)
+	{
+	  if(num > 0xffffffffUL / 10)
+	    {
+	      return -1;
+	    }
+	  num *= 10;
+	  places++;
+	}
+    }
+
+  *mag = num;
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  void _print_number(unsigned int x ,unsigned int y,
+*                               unsigned long mag ,unsigned char negative,
+*                               unsigned int decimals ,unsigned int width)
+* @brief     print a fixed-point number right aligned in 'width' cells.
+*            'mag' is the absolute value * 10^decimals.
+*            The digits are turned into glyphs from the right ,no string is
+*            built. The free cells on the left are blank.
+*            width = 0 --> as many cells as needed
+*            When the number does not fit in 'width' ,all cells are '#'.
+*            Characters missing in the font (SevenSegNumFont '-' '.') are
+*            blank cells.
+********************************************************************************
+**/
+static void _print_number(unsigned int x ,unsigned int y,
+			  unsigned long mag ,unsigned char negative,
+			  unsigned int decimals ,unsigned int width)
+{
+  const unsigned char *bits[LCD_LINE_WORDS / 4];
+  unsigned int len, cell, places;
+  unsigned long tmp;
+
+  /* cells needed : digits (at least one before the point) ,'.' ,'-' */
+  len = 1;
+  for(tmp = mag / 10; tmp != 0; tmp /= 10)
+    {
+      len++;
+    }
+  if(len < decimals + 1)
+    {
+      len = decimals + 1;
+    }
+  len += (decimals != 0)? 1 : 0;
+  len += negative;
+
+  if(width == 0)
+    {
+      width = len;
+    }
+  if(width > LCD_LINE_WORDS / 4 ||
+     x + width * cfont.x_size > display_x ||
+     y + cfont.y_size > display_y)
+    {
+      return;
+    }
+
+  cell = width;
+  if(len > width)
+    {
+      while(cell != 0)
+	{
+	  bits[--cell] = _GlyphBits('#');
+	}
+    }
+  else
+    {
+      places = 0;
+      do
+	{
+	  if(places == decimals && decimals != 0)
+	    {
+	      bits[--cell] = _GlyphBits('.');
+	    }
+	  bits[--cell] = _GlyphBits((unsigned char)('0' + mag % 10));
+	  mag /= 10;
+	  places++;
+	}
+      while(mag != 0 || places <= decimals);
+
+      if(negative != 0)
+	{
+	  bits[--cell] = _GlyphBits('-');
+	}
+      while(cell != 0)
+	{
+	  bits[--cell] = 0;    /* blank */
+	}
+    }
+
+  _print_glyphs(x, y, bits, width);
+}
+
+/**
+********************************************************************************
+* @function  void PrintInteger(unsigned char **args, int arg_num)
+* @brief     print an integer ,args : x ,y ,value [,width]
+*            value : decimal ,"0x" hexadecimal or "0b" binary ,may be
+*            negative. It is printed in decimal ,right aligned in 'width'
+*            cells.
+********************************************************************************
+**/
+static void PrintInteger(unsigned char **args, int arg_num)
+{
+  unsigned long mag;
+  unsigned char negative;
+  unsigned int width;
+
+  if(arg_num != 3 && arg_num != 4)
+    {
+      return;
+    }
+
+  if(str_to_number(*(args + 2), 0, &mag, &negative) != 0)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Not a number.\n");
+	}
+      return;
+    }
+
+  width = (arg_num == 4)? str_to_uint(*(args + 3)) : 0;
+  _print_number(str_to_uint(*args), str_to_uint(*(args + 1)),
+		mag, negative, 0, width);
+}
+
+/**
+********************************************************************************
+* @function  void PrintFloat(unsigned char **args, int arg_num)
+* @brief     print a fixed-point number ,
+*            args : x ,y ,value ,width ,decimals
+*            value : decimal like "-12.345" ,rounded to 'decimals' places ,
+*                    or "0x"/"0b" value already scaled by 10^decimals.
+*            No float arithmetic is used.
+*            decimals --> 0 ~ 9
+********************************************************************************
+**/
+static void PrintFloat(unsigned char **args, int arg_num)
+{
+  unsigned long mag;
+  unsigned char negative;
+  unsigned int decimals;
+
+  if(arg_num != 5)
+    {
+      return;
+    }
+
+  decimals = str_to_uint(*(args + 4));
+  if(decimals > 9 ||
+     str_to_number(*(args + 2), decimals, &mag, &negative) != 0)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Not a number.\n");
+	}
+      return;
+    }
+
+  _print_number(str_to_uint(*args), str_to_uint(*(args + 1)),
+		mag, negative, decimals, str_to_uint(*(args + 3)));
+}
+
+/**
+********************************************************************************
+* @variable text_slot
+* @brief    Text slots for texts updated again and again (readouts).
+*           A slot remembers the text on the screen and how it was drawn ,
+*           a new text in the same place only repaints the changed cells.
+*           used   --> 0 : free slot
+*           x , y  --> the top left pixel of the text
+*           font , x_size , y_size , front , back , mode
+*                  --> the font ,colors and text mode of the text
+*           epoch  --> screen_epoch when the text was drawn
+*           len    --> characters in 'text'
+********************************************************************************
+**/
+#define TEXT_SLOT_NUM 8
+#define TEXT_SLOT_LEN 30    /* 240 / 8 ,a full line of SmallFont */
+
+struct _text_slot
+{
+  unsigned char used;
+  unsigned int x;
+  unsigned int y;
+  const unsigned char *font;
+  unsigned int x_size;
+  unsigned int y_size;
+  unsigned int front;
+  unsigned int back;
+  unsigned char mode;
+  unsigned int epoch;
+  unsigned int len;
+  unsigned char text[TEXT_SLOT_LEN];
+};
+
+static struct _text_slot text_slot[TEXT_SLOT_NUM];
+
+/**
+********************************************************************************
+* @function  void _print_cells(unsigned int x ,unsigned int y,
+*                              const unsigned char *str ,unsigned int n)
+* @brief     print 'n' characters on one line ,without wrapping.
+*            In TEXT_TRANSPARENT mode the cells are cleared first ,so the
+*            old characters do not show through.
+*            The caller makes sure the text fits in the screen.
+********************************************************************************
+**/
+static void _print_cells(unsigned int x ,unsigned int y,
+			 const unsigned char *str ,unsigned int n)
+{
+  if(text_mode != TEXT_OPAQUE)
+    {
+      _FillWindow(x, y, x + n * cfont.x_size - 1, y + cfont.y_size - 1,
+		  back_color);
+    }
+  _print_line(x, y, str, n);
+}
+
+/**
+********************************************************************************
+* @function  void _EraseTextSlot(struct _text_slot *slot)
+* @brief     Clear the cells of the text in 'slot' with its back color.
+********************************************************************************
+**/
+static void _EraseTextSlot(struct _text_slot *slot)
+{
+  if(slot->len != 0 && slot->epoch == screen_epoch)
+    {
+      _FillWindow(slot->x, slot->y,
+		  slot->x + slot->len * slot->x_size - 1,
+		  slot->y + slot->y_size - 1, slot->back);
+    }
+  slot->len = 0;
+}
+
+/**
+********************************************************************************
+* @function  void TextSlot(unsigned char **args, int arg_num)
+* @brief     Print a text in a text slot ,args : id ,x ,y ,string
+*            Only the cells different from the last text of the slot are
+*            repainted ,and the cells left over by a longer last text are
+*            cleared.
+*            The whole text is repainted when the position ,font ,colors
+*            or text mode changed ,or the screen was cleared.
+*            The text is not wrapped ,characters beyond the screen edge are
+*            dropped.
+*            With only the id ,the slot text is cleared and the slot freed.
+********************************************************************************
+**/
+static void TextSlot(unsigned char **args, int arg_num)
+{
+  struct _text_slot *slot;
+  unsigned int id, x, y, n, old_len, i, start;
+  unsigned char *str;
+
+  if(arg_num != 1 && arg_num != 4)
+    {
+      return;
+    }
+
+  id = str_to_uint(*args);
+  if(id >= TEXT_SLOT_NUM)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Text slot is 0 ~ %d.\n",TEXT_SLOT_NUM - 1);
+	}
+      return;
+    }
+  slot = &text_slot[id];
+
+  if(arg_num == 1)
+    {
+      if(slot->used != 0)
+	{
+	  _EraseTextSlot(slot);
+	}
+      slot->used = 0;
+      return;
+    }
+
+  x = str_to_uint(*(args + 1));
+  y = str_to_uint(*(args + 2));
+  str = *(args + 3);
+  if(x >= display_x - cfont.x_size || y >= display_y - cfont.y_size)
+    {
+      return;
+    }
+
+  n = strlen((const char *)str);
+  if(n > TEXT_SLOT_LEN)
+    {
+      n = TEXT_SLOT_LEN;
+    }
+  if(x + n * cfont.x_size > display_x)
+    {
+      n = (display_x - x) / cfont.x_size;
+    }
+
+  if(slot->used != 0 &&
+     (slot->x != x || slot->y != y || slot->font != cfont.font ||
+      slot->front != front_color || slot->back != back_color ||
+      slot->mode != text_mode))
+    {
+      _EraseTextSlot(slot);
+    }
+  if(slot->used == 0 || slot->epoch != screen_epoch)
+    {
+      slot->len = 0;
+    }
+  old_len = slot->len;
+
+  /* repaint the runs of changed cells */
+  i = 0;
+  while(i < n)
+    {
+      if(i < old_len && slot->text[i] == str[i])
+	{
+	  i++;
+	  continue;
+	}
+      start = i;
+      while(i < n && (i >= old_len || slot->text[i] != str[i]))
+	{
+	  i++;
+	}
+      _print_cells(x + start * cfont.x_size, y, str + start, i - start);
+    }
+
+  /* clear the cells of the last text beyond the new one */
+  if(old_len > n)
+    {
+      _FillWindow(x + n * cfont.x_size, y,
+		  x + old_len * cfont.x_size - 1, y + cfont.y_size - 1,
+		  back_color);
+    }
+
+  slot->used = 1;
+  slot->x = x;
+  slot->y = y;
+  slot->font = cfont.font;
+  slot->x_size = cfont.x_size;
+  slot->y_size = cfont.y_size;
+  slot->front = front_color;
+  slot->back = back_color;
+  slot->mode = text_mode;
+  slot->epoch = screen_epoch;
+  slot->len = n;
+  memcpy(slot->text, str, n);
+}
+
+/**
+********************************************************************************
+* @variable console
+* @brief    Console mode state.
+*           In console mode the bytes from the UART which are not AT commands
+*           are printed as text in the current font.
+*           The text cells are counted in screen lines ,GRAM line =
+*           (screen line + shadow.scroll) % display_y. When the cursor passes
+*           the bottom ,the screen is scrolled by one text row with R41h and
+*           only the new bottom row is cleared.
+*           active       --> 1 : console mode is on
+*           col , row    --> the cursor cell
+*           esc          --> escape sequence state (CONSOLE_ESC_xxx)
+*           param ,nparam --> the numbers of a "ESC [" sequence
+*           front , back --> the colors before console mode
+********************************************************************************
+**/
+#define CONSOLE_ESC_NONE  0
+#define CONSOLE_ESC_START 1   /* got ESC        */
+#define CONSOLE_ESC_CSI   2   /* got "ESC ["    */
+#define CONSOLE_MAX_PARAM 4
+
+struct _console
+{
+  unsigned char active;
+  unsigned int col;
+  unsigned int row;
+  unsigned char esc;
+  unsigned int param[CONSOLE_MAX_PARAM];
+  unsigned int nparam;
+  unsigned int front;
+  unsigned int back;
+};
+
+static struct _console console;
+
+/* ANSI colors 0 ~ 7 (black ,red ,green ,yellow ,blue ,magenta ,cyan ,white) */
+static const unsigned int ansi_color[8] =
+  {
+    0x0000, 0xF800, 0x07E0, 0xFFE0, 0x001F, 0xF81F, 0x07FF, 0xFFFF
+  };
+
+/**
+********************************************************************************
+* @function  void _ConsoleFill(unsigned int x0 ,unsigned int x1,
+*                              unsigned int v ,unsigned int n)
+* @brief     Clear the pixels x0 ~ x1 of the screen lines v ~ v+n-1 with
+*            back_color. The lines are wrapped at the bottom of the GRAM.
+*            Note: x0 <= x1 , v + n <= display_y
+********************************************************************************
+**/
+static void _ConsoleFill(unsigned int x0 ,unsigned int x1,
+			 unsigned int v ,unsigned int n)
+{
+  unsigned int y, first;
+
+  if(n == 0)
+    {
+      return;
+    }
+  y = (v + shadow.scroll) % display_y;
+  first = display_y - y;
+  if(first >= n)
+    {
+      _FillWindow(x0, y, x1, y + n - 1, back_color);
+      return;
+    }
+  _FillWindow(x0, y, x1, display_y - 1, back_color);
+  _FillWindow(x0, 0, x1, n - first - 1, back_color);
+}
+
+/**
+********************************************************************************
+* @function  void _ConsoleGlyph(unsigned int x ,unsigned int v,
+*                               unsigned char c)
+* @brief     print a character cell at screen line 'v'.
+*            A cell crossing the bottom of the GRAM is sent in two windows.
+*            The glyph rows are expanded into line_buf as many as fit.
+*            Console text is always opaque.
+********************************************************************************
+**/
+static void _ConsoleGlyph(unsigned int x ,unsigned int v ,unsigned char c)
+{
+  const unsigned char *bits;
+  unsigned int y, row, rows, end, chunk, row_bytes;
+
+  bits = _GlyphBits(c);
+  row_bytes = cfont.x_size / 8;
+  _UpdateGlyphLUT();
+
+  y = (v + shadow.scroll) % display_y;
+  row = 0;
+  while(row < cfont.y_size)
+    {
+      /* rows up to the bottom of the GRAM */
+      end = row + (display_y - y);
+      if(end > cfont.y_size)
+	{
+	  end = cfont.y_size;
+	}
+      SetXY(x, y, x + cfont.x_size - 1, y + (end - row) - 1);
+
+      if(bits == 0)
+	{
+	  lcd_fill_pixels(back_color, (end - row) * cfont.x_size);
+	  row = end;
+	}
+      chunk = (LCD_LINE_WORDS * 2) / cfont.x_size;
+      while(row < end)
+	{
+	  rows = (end - row < chunk)? end - row : chunk;
+	  _ExpandGlyph(bits + row * row_bytes, rows * row_bytes, line_buf);
+	  lcd_write_pixels((const uint16_t *)line_buf, rows * cfont.x_size);
+	  row += rows;
+	}
+      y = 0;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _ConsoleNewLine(void)
+* @brief     Move the cursor to the start of the next line.
+*            Below the last text row ,the screen is scrolled up one text row
+*            by R41h ,and the new last row (and the lines below it) cleared.
+********************************************************************************
+**/
+static void _ConsoleNewLine(void)
+{
+  unsigned int rows, v;
+
+  rows = display_y / cfont.y_size;
+  console.col = 0;
+  if(console.row + 1 < rows)
+    {
+      console.row++;
+      return;
+    }
+
+  console.row = rows - 1;
+  SetScroll((shadow.scroll + cfont.y_size) % display_y);
+  v = console.row * cfont.y_size;
+  _ConsoleFill(0, display_x - 1, v, display_y - v);
+}
+
+/**
+********************************************************************************
+* @function  void _ConsoleClear(void)
+* @brief     Clear the screen ,reset the scroll and home the cursor.
+********************************************************************************
+**/
+static void _ConsoleClear(void)
+{
+  SetScroll(0);
+  _FillWindow(0, 0, display_x - 1, display_y - 1, back_color);
+  screen_epoch++;
+  console.col = 0;
+  console.row = 0;
+}
+
+/**
+********************************************************************************
+* @function  void _ConsoleEscape(unsigned char c)
+* @brief     Run the "ESC [" sequence ending with 'c'.
+*            A , B , C , D  --> cursor up ,down ,right ,left (default 1)
+*            H , f          --> cursor to row;col (1 based ,default 1;1)
+*            J              --> 2J clears the screen
+*            K              --> clear to the end of the line
+*            m              --> 0 : colors before console mode
+*                               30~37 , 40~47 : front ,back color
+*                               39 , 49 : default front ,back color
+********************************************************************************
+**/
+static void _ConsoleEscape(unsigned char c)
+{
+  unsigned int cols, rows, n, i;
+
+  cols = display_x / cfont.x_size;
+  rows = display_y / cfont.y_size;
+  n = (console.nparam == 0 || console.param[0] == 0)? 1 : console.param[0];
+
+  switch(c)
+    {
+    case 'A':
+      console.row = (console.row > n)? console.row - n : 0;
+      break;
+    case 'B':
+      console.row = (console.row + n < rows)? console.row + n : rows - 1;
+      break;
+    case 'C':
+      console.col = (console.col + n < cols)? console.col + n : cols - 1;
+      break;
+    case 'D':
+      console.col = (console.col > n)? console.col - n : 0;
+      break;
+    case 'H':
+    case 'f':
+      console.row = n - 1;
+      n = (console.nparam < 2 || console.param[1] == 0)? 1 : console.param[1];
+      console.col = n - 1;
+      if(console.row >= rows)
+	{
+	  console.row = rows - 1;
+	}
+      if(console.col >= cols)
+	{
+	  console.col = cols - 1;
+	}
+      break;
+    case 'J':
+      if(console.nparam != 0 && console.param[0] == 2)
+	{
+	  _ConsoleClear();
+	}
+      break;
+    case 'K':
+      if(console.col < cols)
+	{
+	  _ConsoleFill(console.col * cfont.x_size, cols * cfont.x_size - 1,
+		       console.row * cfont.y_size, cfont.y_size);
+	}
+      break;
+    case 'm':
+      if(console.nparam == 0)
+	{
+	  console.param[0] = 0;
+	  console.nparam = 1;
+	}
+      for(i = 0; i < console.nparam; i++)
+	{
+	  n = console.param[i];
+	  if(n == 0)
+	    {
+	      front_color = console.front;
+	      back_color = console.back;
+	    }
+	  else if(n >= 30 && n <= 37)
+	    {
+	      front_color = ansi_color[n - 30];
+	    }
+	  else if(n >= 40 && n <= 47)
+	    {
+	      back_color = ansi_color[n - 40];
+	    }
+	  else if(n == 39)
+	    {
+	      front_color = console.front;
+	    }
+	  else if(n == 49)
+	    {
+	      back_color = console.back;
+	    }
+	}
+      break;
+    default:
+      break;
+    }
+}
+
+/**
+********************************************************************************
+* @function  int ConsolePutc(unsigned char c)
+* @brief     Print a character from the UART in console mode.
+*            '\r' --> start of the line       '\n' --> start of the next line
+*            '\t' --> next 8th column         '\b' --> one column back
+*            ESC --> escape sequence ,see _ConsoleEscape()
+*            Other control characters are ignored.
+* @return    0  --> the character is taken
+*            -1 --> console mode is off
+********************************************************************************
+**/
+static int ConsolePutc(unsigned char c)
+{
+  unsigned int cols;
+
+  if(console.active == 0)
+    {
+      return -1;
+    }
+
+  cols = display_x / cfont.x_size;
+
+  switch(console.esc)
+    {
+    case CONSOLE_ESC_START:
+      console.esc = (c == '[')? CONSOLE_ESC_CSI : CONSOLE_ESC_NONE;
+      console.nparam = 0;
+      console.param[0] = 0;
+      return 0;
+    case CONSOLE_ESC_CSI:
+      if(c >= '0' && c <= '9')
+	{
+	  if(console.nparam == 0)
+	    {
+	      console.nparam = 1;
+	    }
+	  if(console.nparam <= CONSOLE_MAX_PARAM)
+	    {
+	      console.param[console.nparam - 1] =
+		console.param[console.nparam - 1] * 10 + (c - '0');
+	    }
+	  return 0;
+	}
+      if(c == ';')
+	{
+	  if(console.nparam == 0)
+	    {
+	      console.nparam = 1;
+	    }
+	  if(console.nparam < CONSOLE_MAX_PARAM)
+	    {
+	      console.param[console.nparam] = 0;
+	    }
+	  console.nparam++;
+	  return 0;
+	}
+      if(console.nparam > CONSOLE_MAX_PARAM)
+	{
+	  console.nparam = CONSOLE_MAX_PARAM;
+	}
+      console.esc = CONSOLE_ESC_NONE;
+      _ConsoleEscape(c);
+      return 0;
+    default:
+      break;
+    }
+
+  switch(c)
+    {
+    case 0x1b:
+      console.esc = CONSOLE_ESC_START;
+      break;
+    case '\r':
+      console.col = 0;
+      break;
+    case '\n':
+      _ConsoleNewLine();
+      break;
+    case '\t':
+      console.col = (console.col + 8) & ~7U;
+      if(console.col >= cols)
+	{
+	  _ConsoleNewLine();
+	}
+      break;
+    case '\b':
+      if(console.col != 0)
+	{
+	  console.col--;
+	}
+      break;
+    default:
+      if(c < ' ')
+	{
+	  break;
+	}
+      if(console.col >= cols)  /* wrap before the character */
+	{
+	  _ConsoleNewLine();
+	}
+      _ConsoleGlyph(console.col * cfont.x_size, console.row * cfont.y_size, c);
+      console.col++;
+      break;
+    }
+  return 0;
+}
+
+/**
+********************************************************************************
+* @function  void ConsoleMode(unsigned char **args, int arg_num)
+* @brief     '1' --> enter console mode ,the screen is cleared
+*            '0' --> leave console mode ,the colors are restored ,the scroll
+*                    is reset and the screen is cleared
+*            AT commands still work in console mode ,but their coordinates
+*            are GRAM coordinates ,which move with the scroll.
+********************************************************************************
+**/
+static void ConsoleMode(unsigned char **args, int arg_num)
+{
+  if(arg_num != 1)
+    {
+      return;
+    }
+
+  switch(**args)
+    {
+    case '1':
+      if(console.active == 0)
+	{
+	  console.front = front_color;
+	  console.back = back_color;
+	}
+      console.active = 1;
+      console.esc = CONSOLE_ESC_NONE;
+      _ConsoleClear();
+      break;
+    case '0':
+      if(console.active != 0)
+	{
+	  front_color = console.front;
+	  back_color = console.back;
+	  console.active = 0;
+	  _ConsoleClear();
+	}
+      break;
+    default:
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Parameter is not '0' or '1'.\n");
+	}
+      break;
+    }
+}
+
+/**
+********************************************************************************
+* @variable tile
+* @brief    The tile being composited from the frame display list.
+*           x , y  --> the top left pixel of the tile
+*           color  --> the color of the span sink _TileSpans()
+*           mask[] --> the drawn pixels ,bit n of mask[row] is pixel n
+*           buf[]  --> the tile pixels ,row by row
+********************************************************************************
+**/
+#define FRAME_TILE 16
+#define FRAME_MAX_TILES ((240 / FRAME_TILE) * (320 / FRAME_TILE)) /* HX8347A */
+
+struct _tile
+{
+  unsigned int x;
+  unsigned int y;
+  unsigned int color;
+  uint16_t mask[FRAME_TILE];
+  uint16_t buf[FRAME_TILE * FRAME_TILE];
+};
+
+static struct _tile tile;
+
+/**
+********************************************************************************
+* @function  void _TileFill(int x0 ,int y0 ,int x1 ,int y1 ,unsigned int color)
+* @brief     Fill the part of the rectangle (x0 ,y0) ~ (x1 ,y1) in the tile.
+********************************************************************************
+**/
+static void _TileFill(int x0 ,int y0 ,int x1 ,int y1 ,unsigned int color)
+{
+  int x, y;
+  uint16_t bits;
+
+  if(x0 < (int)tile.x)
+    {
+      x0 = tile.x;
+    }
+  if(y0 < (int)tile.y)
+    {
+      y0 = tile.y;
+    }
+  if(x1 > (int)tile.x + FRAME_TILE - 1)
+    {
+      x1 = tile.x + FRAME_TILE - 1;
+    }
+  if(y1 > (int)tile.y + FRAME_TILE - 1)
+    {
+      y1 = tile.y + FRAME_TILE - 1;
+    }
+  if(x0 > x1 || y0 > y1)
+    {
+      return;
+    }
+
+  x0 -= tile.x;
+  x1 -= tile.x;
+  bits = (uint16_t)(((1UL << (x1 + 1)) - 1) & ~((1UL << x0) - 1));
+  for(y = y0 - tile.y; y <= y1 - (int)tile.y; y++)
+    {
+      for(x = x0; x <= x1; x++)
+	{
+	  tile.buf[y * FRAME_TILE + x] = (uint16_t)color;
+	}
+      tile.mask[y] |= bits;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _TileSpans(int x0, int x1, int y, int h)
+* @brief     Span sink that fills the tile with tile.color.
+********************************************************************************
+**/
+static void _TileSpans(int x0, int x1, int y, int h)
+{
+  _TileFill(x0, y, x1, y + h - 1, tile.color);
+}
+
+/**
+********************************************************************************
+* @function  void _TileLine(const struct _frame_op *op)
+* @brief     Draw the part of a line in the tile.
+*            The pixels are the same as _DrawLine_A() draws.
+********************************************************************************
+**/
+static void _TileLine(const struct _frame_op *op)
+{
+  int x0, y0, x1, y1, tmp, delta_x, delta_y, d, dinc1, dinc2, step, x, y;
+
+  x0 = op->x0; y0 = op->y0; x1 = op->x1; y1 = op->y1;
+  if(x0 == x1 || y0 == y1)
+    {
+      _TileFill((x0 < x1)? x0 : x1, (y0 < y1)? y0 : y1,
+		(x0 < x1)? x1 : x0, (y0 < y1)? y1 : y0, op->front);
+      return;
+    }
+
+  delta_x = (x1 > x0)?(x1 - x0):(x0 - x1);
+  delta_y = (y1 > y0)?(y1 - y0):(y0 - y1);
+  if(delta_x >= delta_y)
+    {
+      if(x0 > x1)
+	{
+	  tmp = x0; x0 = x1; x1 = tmp;
+	  tmp = y0; y0 = y1; y1 = tmp;
+	}
+      step = (y1 > y0)? 1 : -1;
+      d = (delta_y << 1) - delta_x;
+      dinc1 = delta_y << 1;
+      dinc2 = (delta_y - delta_x) << 1;
+      for(x = x0, y = y0; x <= x1; x++)
+	{
+	  _TileFill(x, y, x, y, op->front);
+	  if(d < 0)
+	    {
+	      d += dinc1;
+	    }
+	  else
+	    {
+	      d += dinc2;
+	      y += step;
+	    }
+	}
+    }
+  else
+    {
+      if(y0 > y1)
+	{
+	  tmp = x0; x0 = x1; x1 = tmp;
+	  tmp = y0; y0 = y1; y1 = tmp;
+	}
+      step = (x1 > x0)? 1 : -1;
+      d = (delta_x << 1) - delta_y;
+      dinc1 = delta_x << 1;
+      dinc2 = (delta_x - delta_y) << 1;
+      for(y = y0, x = x0; y <= y1; y++)
+	{
+	  _TileFill(x, y, x, y, op->front);
+	  if(d < 0)
+	    {
+	      d += dinc1;
+	    }
+	  else
+	    {
+	      d += dinc2;
+	      x += step;
+	    }
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _TileText(const struct _frame_op *op)
+* @brief     Draw the part of a text line in the tile.
+*            Opaque text fills its cells ,transparent text only the set bits.
+********************************************************************************
+**/
+static void _TileText(const struct _frame_op *op)
+{
+  unsigned int w, h, offset, numchars, row_bytes, i, c;
+  int cx, x, y, xs, xe, ys, ye;
+  const unsigned char *bits;
+
+  w = op->font[0];
+  h = op->font[1];
+  offset = op->font[2];
+  numchars = op->font[3];
+  row_bytes = w / 8;
+
+  ys = (op->y0 > tile.y)? op->y0 : tile.y;
+  ye = op->y0 + h - 1;
+  if(ye > (int)tile.y + FRAME_TILE - 1)
+    {
+      ye = tile.y + FRAME_TILE - 1;
+    }
+
+  for(i = 0; i < op->len; i++)
+    {
+      cx = op->x0 + i * w;
+      xs = (cx > (int)tile.x)? cx : (int)tile.x;
+      xe = cx + w - 1;
+      if(xe > (int)tile.x + FRAME_TILE - 1)
+	{
+	  xe = tile.x + FRAME_TILE - 1;
+	}
+      if(xs > xe)
+	{
+	  continue;
+	}
+
+      c = frame_text[op->r + i];
+      bits = (c < offset || c >= offset + numchars)? 0 :
+	op->font + 4 + (c - offset) * row_bytes * h;
+
+      for(y = ys; y <= ye; y++)
+	{
+	  for(x = xs; x <= xe; x++)
+	    {
+	      if(bits != 0 &&
+		 (bits[(y - op->y0) * row_bytes + ((x - cx) >> 3)] &
+		  (0x80 >> ((x - cx) & 7))) != 0)
+		{
+		  _TileFill(x, y, x, y, op->front);
+		}
+	      else if(op->mode == TEXT_OPAQUE)
+		{
+		  _TileFill(x, y, x, y, op->back);
+		}
+	    }
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _TileFlush(void)
+* @brief     Send the drawn pixels of the tile.
+*            A fully drawn tile is one window and one burst ,otherwise every
+*            run of drawn pixels is one cursor move and one burst.
+********************************************************************************
+**/
+static void _TileFlush(void)
+{
+  unsigned int row, start, end, whole;
+
+  whole = 1;
+  for(row = 0; row < FRAME_TILE; row++)
+    {
+      if(tile.mask[row] != 0xffff)
+	{
+	  whole = 0;
+	  break;
+	}
+    }
+
+  if(whole != 0)
+    {
+      SetXY(tile.x, tile.y, tile.x + FRAME_TILE - 1, tile.y + FRAME_TILE - 1);
+      lcd_write_pixels(tile.buf, FRAME_TILE * FRAME_TILE);
+      return;
+    }
+
+  for(row = 0; row < FRAME_TILE; row++)
+    {
+      start = 0;
+      while(start < FRAME_TILE)
+	{
+	  if((tile.mask[row] & (1 << start)) == 0)
+	    {
+	      start++;
+	      continue;
+	    }
+	  end = start;
+	  while(end < FRAME_TILE && (tile.mask[row] & (1 << end)) != 0)
+	    {
+	      end++;
+	    }
+	  SetSpan(tile.x + start, tile.x + end - 1, tile.y + row);
+	  lcd_write_pixels(&tile.buf[row * FRAME_TILE + start], end - start);
+	  start = end;
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _FrameRender(void)
+* @brief     Draw the frame display list and empty it.
+*            Every 16x16 tile touched by an operation is composited in RAM
+*            from all the operations over it ,in the list order ,and then
+*            sent once. Each pixel goes to the GRAM at most once.
+********************************************************************************
+**/
+static void _FrameRender(void)
+{
+  uint32_t touched[(FRAME_MAX_TILES + 31) / 32];
+  unsigned int i, n, tx, ty, tiles_x, tiles_y, x0, y0, x1, y1;
+  const struct _frame_op *op;
+
+  if(frame.busy != 0 || frame.count == 0)
+    {
+      return;
+    }
+  frame.busy = 1;
+
+  tiles_x = display_x / FRAME_TILE;
+  tiles_y = display_y / FRAME_TILE;
+  for(i = 0; i < sizeof(touched) / sizeof(touched[0]); i++)
+    {
+      touched[i] = 0;
+    }
+
+  /* mark the tiles under the bounding box of every operation */
+  for(i = 0; i < frame.count; i++)
+    {
+      op = &frame_op[i];
+      x0 = ((op->x0 < op->x1)? op->x0 : op->x1) / FRAME_TILE;
+      x1 = ((op->x0 < op->x1)? op->x1 : op->x0) / FRAME_TILE;
+      y0 = ((op->y0 < op->y1)? op->y0 : op->y1) / FRAME_TILE;
+      y1 = ((op->y0 < op->y1)? op->y1 : op->y0) / FRAME_TILE;
+      for(ty = y0; ty <= y1 && ty < tiles_y; ty++)
+	{
+	  for(tx = x0; tx <= x1 && tx < tiles_x; tx++)
+	    {
+	      n = ty * tiles_x + tx;
+	      touched[n >> 5] |= 1UL << (n & 31);
+	    }
+	}
+    }
+
+  SetEntry(LCD_ENTRY_H);
+  for(ty = 0; ty < tiles_y; ty++)
+    {
+      for(tx = 0; tx < tiles_x; tx++)
+	{
+	  n = ty * tiles_x + tx;
+	  if((touched[n >> 5] & (1UL << (n & 31))) == 0)
+	    {
+	      continue;
+	    }
+
+	  tile.x = tx * FRAME_TILE;
+	  tile.y = ty * FRAME_TILE;
+	  for(i = 0; i < FRAME_TILE; i++)
+	    {
+	      tile.mask[i] = 0;
+	    }
+
+	  for(i = 0; i < frame.count; i++)
+	    {
+	      op = &frame_op[i];
+	      x0 = (op->x0 < op->x1)? op->x0 : op->x1;
+	      x1 = (op->x0 < op->x1)? op->x1 : op->x0;
+	      y0 = (op->y0 < op->y1)? op->y0 : op->y1;
+	      y1 = (op->y0 < op->y1)? op->y1 : op->y0;
+	      if(x1 < tile.x || x0 >= tile.x + FRAME_TILE ||
+		 y1 < tile.y || y0 >= tile.y + FRAME_TILE)
+		{
+		  continue;
+		}
+
+	      switch(op->type)
+		{
+		case FRAME_RECT:
+		  _TileFill(x0, y0, x1, y1, op->front);
+		  break;
+		case FRAME_RRECT:
+		  tile.color = op->front;
+		  _RoundRectSpans(x0, y0, x1, y1, op->r, _TileSpans);
+		  break;
+		case FRAME_LINE:
+		  _TileLine(op);
+		  break;
+		case FRAME_TEXT:
+		default:
+		  _TileText(op);
+		  break;
+		}
+	    }
+	  _TileFlush();
+	}
+    }
+
+  frame.count = 0;
+  frame.text = 0;
+  frame.busy = 0;
+}
+
+/**
+********************************************************************************
+* @function  void BeginFrame(unsigned char **args, int arg_num)
+* @brief     Start a frame ,the drawings are kept in the display list until
+*            EndFrame. Starting a frame in a frame draws the list so far.
+*            The culling queue is drawn first ,it stays empty in a frame
+*            (see _CullAdd) ,so the list is never drawn before older fills.
+********************************************************************************
+**/
+static void BeginFrame(unsigned char **args, int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+
+  _CullFlush();
+  _FrameRender();
+  frame.active = 1;
+}
+
+/**
+********************************************************************************
+* @function  void EndFrame(unsigned char **args, int arg_num)
+* @brief     End a frame ,draw the display list.
+********************************************************************************
+**/
+static void EndFrame(unsigned char **args, int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+
+  _FrameRender();
+  frame.active = 0;
+}
+
+/**
+********************************************************************************
+* @function  void _FlushPending(void)
+* @brief     Draw everything kept back ,the culling queue first (it is never
+*            added to in a frame ,so it is older than the display list).
+*            This is the bus_hook.
+********************************************************************************
+**/
+static void _FlushPending(void)
+{
+  _CullFlush();
+  _FrameRender();
+}
+
+/**
+********************************************************************************
+* @function  void _SetFontData(const unsigned char *font)
+* @brief     Make 'font' (in file "DefaultFonts.h") the current font.
+********************************************************************************
+**/
+static void _SetFontData(const unsigned char *font)
+{
+  cfont.font = font;
+  cfont.x_size = *cfont.font;
+  cfont.y_size = *(cfont.font + 1);
+  cfont.offset = *(cfont.font + 2);
+  cfont.numchars = *(cfont.font + 3);
+}
+
+/**
+********************************************************************************
+* @function  void SetFont(unsigned char **args, int arg_num)
+* @brief     Choose a font. font in file "DefaultFonts.h"
+********************************************************************************
+**/
+static void SetFont(unsigned char **args, int arg_num)
+{
+  unsigned char font_index;
+
+  if(arg_num != 1)
+    {
+      return;
+    }
+
+  font_index = **args;
+
+  switch(font_index)
+    {
+    case '3':
+      _SetFontData(SevenSegNumFont);
+      break;
+    case '2':
+      _SetFontData(BigFont);
+      break;
+    case '1':
+    default:
+      _SetFontData(SmallFont);
+      break;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void SetTextMode(unsigned char **args, int arg_num)
+* @brief     Choose how text is drawn.
+*            '0' --> opaque ,the character cells are filled (default)
+*            '1' --> transparent ,only the character strokes are drawn
+********************************************************************************
+**/
+static void SetTextMode(unsigned char **args, int arg_num)
+{
+  if(arg_num != 1)
+    {
+      return;
+    }
+
+  switch(**args)
+    {
+    case '1':
+      text_mode = TEXT_TRANSPARENT;
+      break;
+    case '0':
+      text_mode = TEXT_OPAQUE;
+      break;
+    default:
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Parameter is not '0' or '1'.\n");
+	}
+      break;
+    }
+}
+
+/**
+********************************************************************************
+* @function  void ClipPush(unsigned char **args, int arg_num)
+* @brief     AT+cp=x0,y0,x1,y1
+*            Save the clip rectangle and clip to the part of (x0,y0,x1,y1) in
+*            it ,so a pushed clip never grows. The rectangle may be partly
+*            out of the screen.
+********************************************************************************
+**/
+static void ClipPush(unsigned char **args, int arg_num)
+{
+  int location[4] ,tmp;
+  unsigned int count;
+
+  if(arg_num != 4)
+    {
+      return;
+    }
+  if(clip_depth >= CLIP_MAX_DEPTH)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Clip stack is full.\n");
+	}
+      return;
+    }
+
+  for(count = 0 ;count < 4; count++)
+    {
+      location[count] = str_to_int(*(args + count));
+    }
+  if(location[0] > location[2])
+    {
+      tmp = location[0];
+      location[0] = location[2];
+      location[2] = tmp;
+    }
+  if(location[1] > location[3])
+    {
+      tmp = location[1];
+      location[1] = location[3];
+      location[3] = tmp;
+    }
+
+  clip_stack[clip_depth++] = clip;
+  if(_ClipRect(&location[0], &location[1], &location[2], &location[3]) != 0)
+    {
+      clip.x0 = 1;    /* nothing will be drawn */
+      clip.x1 = 0;
+      return;
+    }
+  clip.x0 = location[0];
+  clip.y0 = location[1];
+  clip.x1 = location[2];
+  clip.y1 = location[3];
+}
+
+/**
+********************************************************************************
+* @function  void ClipPop(unsigned char **args, int arg_num)
+* @brief     AT+cP
+*            Go back to the clip rectangle saved by the last AT+cp.
+*            With an empty stack the clip rectangle is the whole screen.
+********************************************************************************
+**/
+static void ClipPop(unsigned char **args, int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+
+  if(clip_depth != 0)
+    {
+      clip = clip_stack[--clip_depth];
+      return;
+    }
+  clip.x0 = 0;
+  clip.y0 = 0;
+  clip.x1 = (int)display_x - 1;
+  clip.y1 = (int)display_y - 1;
+}
+
+/**
+********************************************************************************
+* @variable widget , widget_order , widget_num , dirty , dirty_num
+* @brief    Widgets kept on the device.
+*           A widget is drawn from its own properties ,the host only sends
+*           the changes (AT+wc ,AT+ws ,AT+wd). A change marks the widget
+*           area dirty ,Background() repaints the dirty areas when no change
+*           came for WIDGET_DELAY_MS.
+*           Repainting a dirty area : it grows to the bounds of every
+*           widget it touches ,is cleared to back_color ,then the widgets
+*           over it are drawn bottom up (widget_order[]). Widgets away from
+*           the dirty areas are not touched.
+*           type  --> WIDGET_xxx
+*           x0 , y0 , x1 , y1 --> the bounds
+*           front , back , font --> colors and font when created (or set)
+*           value --> bar : 0 ~ 100 % ,numeric : the number
+*           data  --> label : the text ,icon : 16x16 bits (32 bytes)
+********************************************************************************
+**/
+#define WIDGET_MAX_NUM   16
+#define WIDGET_MAX_DIRTY 4
+#define WIDGET_DATA_SIZE 32
+#define WIDGET_DELAY_MS  5
+
+#define WIDGET_LABEL   'l'
+#define WIDGET_RECT    'r'
+#define WIDGET_BAR     'b'
+#define WIDGET_ICON    'i'
+#define WIDGET_NUMERIC 'n'
+
+struct _widget
+{
+  unsigned char used;
+  unsigned char type;
+  unsigned char hidden;
+  unsigned short x0;
+  unsigned short y0;
+  unsigned short x1;
+  unsigned short y1;
+  unsigned short front;
+  unsigned short back;
+  const unsigned char *font;
+  long value;
+  unsigned char data[WIDGET_DATA_SIZE];
+};
+
+struct _rect
+{
+  unsigned int x0;
+  unsigned int y0;
+  unsigned int x1;
+  unsigned int y1;
+};
+
+static struct _widget widget[WIDGET_MAX_NUM];
+static unsigned char widget_order[WIDGET_MAX_NUM];
+static unsigned int widget_num = 0;
+static struct _rect dirty[WIDGET_MAX_DIRTY];
+static unsigned int dirty_num = 0;
+static uint32_t dirty_time;
+
+/**
+********************************************************************************
+* @function  void _RectUnion(struct _rect *a ,const struct _rect *b)
+* @brief     a = the bounding box of a and b.
+********************************************************************************
+**/
+static void _RectUnion(struct _rect *a ,const struct _rect *b)
+{
+  a->x0 = (a->x0 < b->x0)? a->x0 : b->x0;
+  a->y0 = (a->y0 < b->y0)? a->y0 : b->y0;
+  a->x1 = (a->x1 > b->x1)? a->x1 : b->x1;
+  a->y1 = (a->y1 > b->y1)? a->y1 : b->y1;
+}
+
+/**
+********************************************************************************
+* @function  int _RectTouch(const struct _rect *a ,const struct _rect *b)
+* @return    1 --> a and b overlap or share an edge
+*            0 --> no
+********************************************************************************
+**/
+static int _RectTouch(const struct _rect *a ,const struct _rect *b)
+{
+  return (a->x0 <= b->x1 + 1 && b->x0 <= a->x1 + 1 &&
+	  a->y0 <= b->y1 + 1 && b->y0 <= a->y1 + 1);
+}
+
+/**
+********************************************************************************
+* @function  void _WidgetBounds(const struct _widget *w ,struct _rect *r)
+* @brief     Get the bounds of a widget.
+********************************************************************************
+**/
+static void _WidgetBounds(const struct _widget *w ,struct _rect *r)
+{
+  r->x0 = w->x0;
+  r->y0 = w->y0;
+  r->x1 = w->x1;
+  r->y1 = w->y1;
+}
+
+/**
+********************************************************************************
+* @function  void _DirtyAdd(const struct _rect *r)
+* @brief     Mark an area dirty.
+*            It is merged with the dirty areas it touches. When the list is
+*            full it is merged with the area growing the least.
+********************************************************************************
+**/
+static void _DirtyAdd(const struct _rect *r)
+{
+  struct _rect area, u;
+  unsigned int i, best;
+  unsigned long cost, best_cost;
+
+  area = *r;
+  i = 0;
+  while(i < dirty_num)
+    {
+      if(_RectTouch(&area, &dirty[i]) != 0)
+	{
+	  _RectUnion(&area, &dirty[i]);
+	  dirty[i] = dirty[--dirty_num];    /* taken in ,look again */
+	  i = 0;
+	  continue;
+	}
+      i++;
+    }
+
+  if(dirty_num >= WIDGET_MAX_DIRTY)
+    {
+      best = 0;
+      best_cost = 0xffffffffUL;
+      for(i = 0; i < dirty_num; i++)
+	{
+	  u = dirty[i];
+	  _RectUnion(&u, &area);
+	  cost = (unsigned long)(u.x1 - u.x0 + 1) * (u.y1 - u.y0 + 1) -
+	    (unsigned long)(dirty[i].x1 - dirty[i].x0 + 1) *
+	    (dirty[i].y1 - dirty[i].y0 + 1);
+	  if(cost < best_cost)
+	    {
+	      best_cost = cost;
+	      best = i;
+	    }
+	}
+      u = dirty[best];
+      dirty[best] = dirty[--dirty_num];
+      _RectUnion(&u, &area);
+      _DirtyAdd(&u);
+      return;
+    }
+
+  dirty[dirty_num++] = area;
+  dirty_time = GetTickms();
+}
+
+/**
+********************************************************************************
+* @function  void _WidgetDamage(const struct _widget *w)
+* @brief     Mark the area of a widget dirty.
+********************************************************************************
+**/
+static void _WidgetDamage(const struct _widget *w)
+{
+  struct _rect r;
+
+  _WidgetBounds(w, &r);
+  _DirtyAdd(&r);
+}
+
+/**
+********************************************************************************
+* @function  void _WidgetFill(unsigned int x0 ,unsigned int y0,
+*                             unsigned int x1 ,unsigned int y1,
+*                             unsigned int color)
+* @brief     Opaque fill for widgets ,through the culling queue ,so the
+*            parts covered by the widgets above are not sent.
+*            Nothing is drawn when x0 > x1 or y0 > y1.
+********************************************************************************
+**/
+static void _WidgetFill(unsigned int x0 ,unsigned int y0,
+			unsigned int x1 ,unsigned int y1,
+			unsigned int color)
+{
+  if(x0 > x1 || y0 > y1)
+    {
+      return;
+    }
+  if(_CullAdd(x0, y0, x1, y1, color) != 0)
+    {
+      _FillWindow(x0, y0, x1, y1, color);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void _WidgetDraw(const struct _widget *w)
+* @brief     Draw a widget in its bounds.
+*            label   --> the text from the top left ,the characters beyond
+*                        the bounds are not drawn
+*            rect    --> filled with the front color
+*            bar     --> left 'value' % front color ,the rest back color
+*            icon    --> 16x16 bits from the top left
+*            numeric --> 'value' right aligned in the bounds
+*            The rest of the bounds is back color.
+********************************************************************************
+**/
+static void _WidgetDraw(const struct _widget *w)
+{
+  unsigned int width, height, cells, split, i;
+  unsigned char negative;
+
+  width = w->x1 - w->x0 + 1;
+  height = w->y1 - w->y0 + 1;
+
+  switch(w->type)
+    {
+    case WIDGET_RECT:
+      _WidgetFill(w->x0, w->y0, w->x1, w->y1, w->front);
+      return;
+    case WIDGET_BAR:
+      split = w->x0 + (width * (unsigned long)w->value) / 100;
+      if(split > w->x0)
+	{
+	  _WidgetFill(w->x0, w->y0, split - 1, w->y1, w->front);
+	}
+      _WidgetFill(split, w->y0, w->x1, w->y1, w->back);
+      return;
+    case WIDGET_ICON:
+      front_color = w->front;
+      back_color = w->back;
+      _UpdateGlyphLUT();
+      if(width < 16 || height < 16)
+	{
+	  _WidgetFill(w->x0, w->y0, w->x1, w->y1, w->back);
+	  return;
+	}
+      SetXY(w->x0, w->y0, w->x0 + 15, w->y0 + 15);
+      for(i = 0; i < 32; i += 16)   /* 8 rows (128 pixels) at a time */
+	{
+	  _ExpandGlyph(&w->data[i], 16, line_buf);
+	  lcd_write_pixels((const uint16_t *)line_buf, 128);
+	}
+      _WidgetFill(w->x0 + 16, w->y0, w->x1, w->y0 + 15, w->back);
+      _WidgetFill(w->x0, w->y0 + 16, w->x1, w->y1, w->back);
+      return;
+    case WIDGET_LABEL:
+    case WIDGET_NUMERIC:
+    default:
+      break;
+    }
+
+  /* text widgets */
+  _SetFontData(w->font);
+  front_color = w->front;
+  back_color = w->back;
+  text_mode = TEXT_OPAQUE;
+  cells = (height < cfont.y_size)? 0 : width / cfont.x_size;
+  if(cells > LCD_LINE_WORDS * 2 / cfont.x_size)    /* fits in line_buf */
+    {
+      cells = LCD_LINE_WORDS * 2 / cfont.x_size;
+    }
+  if(w->type == WIDGET_LABEL)
+    {
+      i = strlen((const char *)w->data);
+      cells = (i < cells)? i : cells;
+      if(cells != 0)
+	{
+	  _print_line(w->x0, w->y0, w->data, cells);
+	}
+    }
+  else if(cells != 0)
+    {
+      negative = (w->value < 0)? 1 : 0;
+      _print_number(w->x0, w->y0,
+		    (negative != 0)? 0UL - (unsigned long)w->value :
+		    (unsigned long)w->value, negative, 0, cells);
+    }
+
+  if(cells == 0)
+    {
+      _WidgetFill(w->x0, w->y0, w->x1, w->y1, w->back);
+      return;
+    }
+  _WidgetFill(w->x0 + cells * cfont.x_size, w->y0,
+	      w->x1, w->y0 + cfont.y_size - 1, w->back);
+  _WidgetFill(w->x0, w->y0 + cfont.y_size, w->x1, w->y1, w->back);
+}
+
+/**
+********************************************************************************
+* @function  void _WidgetRepaint(void)
+* @brief     Repaint the dirty areas.
+*            The colors ,font and text mode are restored when done.
+********************************************************************************
+**/
+static void _WidgetRepaint(void)
+{
+  struct _current_font font;
+  unsigned int front, back, n, i, changed;
+  unsigned char mode;
+  struct _rect r, b;
+  struct _widget *w;
+
+  front = front_color;
+  back = back_color;
+  font = cfont;
+  mode = text_mode;
+
+  /* grow the dirty areas to the widgets they touch */
+  do
+    {
+      changed = 0;
+      for(i = 0; i < dirty_num; i++)
+	{
+	  for(n = 0; n < widget_num; n++)
+	    {
+	      w = &widget[widget_order[n]];
+	      _WidgetBounds(w, &b);
+	      r = dirty[i];
+	      if(w->hidden != 0 ||
+		 b.x0 > r.x1 || r.x0 > b.x1 || b.y0 > r.y1 || r.y0 > b.y1)
+		{
+		  continue;    /* not over the area */
+		}
+	      if(b.x0 >= r.x0 && b.y0 >= r.y0 && b.x1 <= r.x1 && b.y1 <= r.y1)
+		{
+		  continue;    /* already in the area */
+		}
+	      _RectUnion(&dirty[i], &b);
+	      changed = 1;
+	    }
+	}
+      /* grown areas may overlap now */
+      for(i = 0; i < dirty_num && changed != 0; i++)
+	{
+	  for(n = i + 1; n < dirty_num; n++)
+	    {
+	      if(_RectTouch(&dirty[i], &dirty[n]) != 0)
+		{
+		  _RectUnion(&dirty[i], &dirty[n]);
+		  dirty[n--] = dirty[--dirty_num];
+		}
+	    }
+	}
+    }
+  while(changed != 0);
+
+  for(i = 0; i < dirty_num; i++)
+    {
+      r = dirty[i];
+      _WidgetFill(r.x0, r.y0, r.x1, r.y1, back);
+      for(n = 0; n < widget_num; n++)
+	{
+	  w = &widget[widget_order[n]];
+	  if(w->hidden == 0 &&
+	     w->x0 <= r.x1 && r.x0 <= w->x1 && w->y0 <= r.y1 && r.y0 <= w->y1)
+	    {
+	      _WidgetDraw(w);
+	    }
+	}
+    }
+  dirty_num = 0;
+
+  front_color = front;
+  back_color = back;
+  cfont = font;
+  text_mode = mode;
+}
+
+/**
+********************************************************************************
+* @function  struct _widget *_WidgetGet(unsigned char *str)
+* @brief     Get the widget of the id string 'str'.
+* @return    the widget ,0 --> wrong id
+********************************************************************************
+**/
+static struct _widget *_WidgetGet(unsigned char *str)
+{
+  unsigned int id;
+
+  id = str_to_uint(str);
+  if(id >= WIDGET_MAX_NUM)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"Widget id is 0 ~ %d.\n",WIDGET_MAX_NUM - 1);
+	}
+      return (struct _widget *)0;
+    }
+  return &widget[id];
+}
+
+/**
+********************************************************************************
+* @function  void _WidgetRemove(struct _widget *w)
+* @brief     Delete a widget ,its area is repainted.
+********************************************************************************
+**/
+static void _WidgetRemove(struct _widget *w)
+{
+  unsigned int n;
+
+  if(w->used == 0)
+    {
+      return;
+    }
+  _WidgetDamage(w);
+  w->used = 0;
+  for(n = 0; n < widget_num; n++)
+    {
+      if(&widget[widget_order[n]] == w)
+	{
+	  widget_num--;
+	  for(; n < widget_num; n++)
+	    {
+	      widget_order[n] = widget_order[n + 1];
+	    }
+	  break;
+	}
+    }
+}
+
+/**
+********************************************************************************
+* @function  void WidgetCreate(unsigned char **args ,int arg_num)
+* @brief     Create a widget ,args : id ,type ,x0 ,y0 ,x1 ,y1
+*            type : 'l' label ,'r' rectangle ,'b' bar ,'i' icon ,
+*                   'n' numeric
+*            The widget takes the current front/back colors and font ,it is
+*            put on top of the other widgets. An old widget with the same id
+*            is deleted first.
+********************************************************************************
+**/
+static void WidgetCreate(unsigned char **args ,int arg_num)
+{
+  struct _widget *w;
+  unsigned int location[4], count, tmp;
+  unsigned char type;
+
+  if(arg_num != 6)
+    {
+      return;
+    }
+
+  w = _WidgetGet(*args);
+  type = **(args + 1);
+  if(w == 0 ||
+     (type != WIDGET_LABEL && type != WIDGET_RECT && type != WIDGET_BAR &&
+      type != WIDGET_ICON && type != WIDGET_NUMERIC))
+    {
+      return;
+    }
+
+  for(count = 0; count < 4; count++)
+    {
+      location[count] = str_to_uint(*(args + 2 + count));
+    }
+  if(location[0] >= display_x || location[2] >= display_x ||
+     location[1] >= display_y || location[3] >= display_y)
+    {
+      return;
+    }
+  if(location[0] > location[2])
+    {
+      tmp = location[0];
+      location[0] = location[2];
+      location[2] = tmp;
+    }
+  if(location[1] > location[3])
+    {
+      tmp = location[1];
+      location[1] = location[3];
+      location[3] = tmp;
+    }
+
+  _WidgetRemove(w);
+  w->used = 1;
+  w->type = type;
+  w->hidden = 0;
+  w->x0 = (unsigned short)location[0];
+  w->y0 = (unsigned short)location[1];
+  w->x1 = (unsigned short)location[2];
+  w->y1 = (unsigned short)location[3];
+  w->front = (unsigned short)front_color;
+  w->back = (unsigned short)back_color;
+  w->font = cfont.font;
+  w->value = 0;
+  memset(w->data, 0, WIDGET_DATA_SIZE);
+  widget_order[widget_num++] = (unsigned char)(w - widget);
+  _WidgetDamage(w);
+}
+
+/**
+********************************************************************************
+* @function  void WidgetSet(unsigned char **args ,int arg_num)
+* @brief     Change a widget property ,args : id ,property ,value [,value]
+*            property :
+*              't' --> text of a label
+*              'v' --> value of a bar (0 ~ 100) or a numeric (may be < 0)
+*              'f' --> front color          'b' --> back color
+*              'F' --> font ,like AT+sF
+*              'm' --> move the top left to x ,y (2 values)
+*              'h' --> '1' hide ,'0' show
+*              'i' --> icon bits ,64 hexadecimal digits ,16 rows of 16 bits
+*            Only a real change repaints the widget.
+********************************************************************************
+**/
+static void WidgetSet(unsigned char **args ,int arg_num)
+{
+  struct _widget *w, old;
+  unsigned char *p, negative;
+  unsigned long mag;
+  unsigned int x, y, i, digit;
+  long value;
+
+  if(arg_num != 3 && arg_num != 4)
+    {
+      return;
+    }
+  w = _WidgetGet(*args);
+  if(w == 0 || w->used == 0)
+    {
+      return;
+    }
+
+  memcpy(&old, w, sizeof(old));
+  p = *(args + 2);
+  switch(**(args + 1))
+    {
+    case 't':
+      strncpy((char *)w->data, (const char *)p, WIDGET_DATA_SIZE - 1);
+      break;
+    case 'v':
+      if(str_to_number(p, 0, &mag, &negative) != 0)
+	{
+	  return;
+	}
+      value = (negative != 0)? -(long)mag : (long)mag;
+      if(w->type == WIDGET_BAR)
+	{
+	  value = (value < 0)? 0 : (value > 100)? 100 : value;
+	}
+      w->value = value;
+      break;
+    case 'f':
+      w->front = (unsigned short)str_to_uint(p);
+      break;
+    case 'b':
+      w->back = (unsigned short)str_to_uint(p);
+      break;
+    case 'F':
+      w->font = (*p == '3')? SevenSegNumFont : (*p == '2')? BigFont : SmallFont;
+      break;
+    case 'm':
+      if(arg_num != 4)
+	{
+	  return;
+	}
+      x = str_to_uint(p);
+      y = str_to_uint(*(args + 3));
+      if(x >= display_x || y >= display_y ||    /* no wrap in the sums */
+	 x + (w->x1 - w->x0) >= display_x || y + (w->y1 - w->y0) >= display_y)
+	{
+	  return;
+	}
+      w->x1 = (unsigned short)(x + (w->x1 - w->x0));
+      w->y1 = (unsigned short)(y + (w->y1 - w->y0));
+      w->x0 = (unsigned short)x;
+      w->y0 = (unsigned short)y;
+      break;
+    case 'h':
+      w->hidden = (*p == '1')? 1 : 0;
+      break;
+    case 'i':
+      memset(w->data, 0, WIDGET_DATA_SIZE);
+      for(i = 0; *p != '\0' && i < WIDGET_DATA_SIZE * 2; p++)
+	{
+	  if(*p >= '0' && *p <= '9')
+	    {
+	      digit = *p - '0';
+	    }
+	  else if(*p >= 'a' && *p <= 'f')
+	    {
+	      digit = *p - 'a' + 10;
+	    }
+	  else if(*p >= 'A' && *p <= 'F')
+	    {
+	      digit = *p - 'A' + 10;
+	    }
+	  else
+	    {
+	      continue;
+	    }
+	  w->data[i >> 1] |= (unsigned char)(digit << (((i & 1) == 0)? 4 : 0));
+	  i++;
+	}
+      break;
+    default:
+      return;
+    }
+
+  if(memcmp(&old, w, sizeof(old)) == 0)
+    {
+      return;    /* nothing changed */
+    }
+  if(old.hidden == 0)
+    {
+      _WidgetDamage(&old);
+    }
+  if(w->hidden == 0)
+    {
+      _WidgetDamage(w);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void WidgetDelete(unsigned char **args ,int arg_num)
+* @brief     Delete a widget ,args : id
+*            Without id ,all the widgets are deleted.
+********************************************************************************
+**/
+static void WidgetDelete(unsigned char **args ,int arg_num)
+{
+  struct _widget *w;
+  unsigned int i;
+
+  if(arg_num == 0)
+    {
+      for(i = 0; i < WIDGET_MAX_NUM; i++)
+	{
+	  _WidgetRemove(&widget[i]);
+	}
+      return;
+    }
+
+  w = _WidgetGet(*args);
+  if(w != 0)
+    {
+      _WidgetRemove(w);
+    }
+}
+
+/**
+********************************************************************************
+* @function  void Background(void)
+* @brief     Called from the main loop.
+*            The culling queue is drawn when nothing was added to it for
+*            CULL_DELAY_MS ,so the last fills of a batch are not held back.
+*            The dirty widget areas are repainted when no widget changed for
+*            WIDGET_DELAY_MS ,so a burst of changes is repainted once.
+*            Not in a frame : the repaint would draw the half built display
+*            list. The areas wait for the first call after AT+EF.
+********************************************************************************
+**/
+static void Background(void)
+{
+  if(dirty_num != 0 && frame.active == 0 &&
+     GetTickms() - dirty_time >= WIDGET_DELAY_MS)
+    {
+      _WidgetRepaint();
+    }
+  if(cull.count != 0 && GetTickms() - cull.time >= CULL_DELAY_MS)
+    {
+      _CullFlush();
+    }
+}
+
+/**
+********************************************************************************
+* @function  void GetFont_uart1(unsigned char **args, int arg_num)
+* @brief     print the current font name to usart1
+********************************************************************************
+**/
+static void GetFont_uart1(unsigned char **args, int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+
+  if(cfont.font == SmallFont)
+    {
+      usart1.printf(&usart1,"The current font name is 'SmallFont'\n");
+    }
+  else if(cfont.font == BigFont)
+    {
+      usart1.printf(&usart1,"The current font name is 'BigFont'\n");
+    }
+  else if(cfont.font == SevenSegNumFont)
+    {
+      usart1.printf(&usart1,"The current font name is 'SevenSegNumFont'\n");
+    }
+  else
+    {
+      usart1.printf(&usart1,"The current font is unknown.\n");
+    }
+
+  usart1.printf(&usart1,"Font X_size is %d\n",cfont.x_size);
+  usart1.printf(&usart1,"Font Y_size is %d\n",cfont.y_size);
+  usart1.printf(&usart1,"Font characters num is %d\n",cfont.numchars);
+}
+
+/**
+********************************************************************************
+* @function  void GetFontXSize_uart1(unsigned char **args ,int arg_num)
+* @brief     print current font xsize to usart1.
+********************************************************************************
+**/
+static void GetFontXSize_uart1(unsigned char **args ,int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+  usart1.printf(&usart1,"Current font X_size is %d\n",cfont.x_size);
+}
+
+/**
+********************************************************************************
+* @function  void GetFontYSize_uart1(unsigned char **args ,int arg_num)
+* @brief     print current font xsize to usart1.
+********************************************************************************
+**/
+static void GetFontYSize_uart1(unsigned char **args ,int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+  usart1.printf(&usart1,"Current font Y_size is %d\n",cfont.y_size);
+}
+
+
+/**
+********************************************************************************
+* @function  void GetDisplayXSize_uart1(unsigned char **args ,int arg_num)
+* @brief     print current LCD diplay area xsize to usart1.
+********************************************************************************
+**/
+static void GetDisplayXSize_uart1(unsigned char **args ,int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+  usart1.printf(&usart1,"Current LCD x_size is %d\n",display_x);
+}
+
+/**
+********************************************************************************
+* @function  void GetDisplayYSize_uart1(unsigned char **args ,int arg_num)
+* @brief     print current LCD diplay area ysize to usart1.
+********************************************************************************
+**/
+static void GetDisplayYSize_uart1(unsigned char **args ,int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+  usart1.printf(&usart1,"Current LCD y_size is %d\n",display_y);
+}
+
+/**
+********************************************************************************
+* @function  void GetStatistics_uart1(unsigned char **args ,int arg_num)
+* @brief     print the LCD bus statistics to usart1.
+*            With parameter '0' ,the counters are cleared.
+********************************************************************************
+**/
+static void GetStatistics_uart1(unsigned char **args ,int arg_num)
+{
+  if(arg_num == 1 && **args == '0')
+    {
+      reg_written = 0;
+      reg_skipped = 0;
+      pixels_culled = 0;
+      return;
+    }
+
+  usart1.printf(&usart1,"Register writes sent %lu\n",reg_written);
+  usart1.printf(&usart1,"Register writes saved %lu\n",reg_skipped);
+  usart1.printf(&usart1,"Pixels culled %lu\n",pixels_culled);
+}
+
+/**
+********************************************************************************
+* @function  void DeviceOn(unsigned char **args ,int arg_num)
+* @brief     turn on the back light .
+********************************************************************************
+**/
+static void DeviceOn(unsigned char **args ,int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++;
+      return ;
+    }
+ if(usart1.debug == 1)
+   {
+     usart1.printf(&usart1,"Device on\n");
+   }
+  GPIO_SetBits(GPIOD, GPIO_Pin_3);
+}
+
+
+/**
+********************************************************************************
+* @function  void DeviceOff(unsigned char **args ,int arg_num)
+* @brief     turn off the back light.
+********************************************************************************
+**/
+static void DeviceOff(unsigned char **args ,int arg_num)
+{
+  if(arg_num != 0)
+    {
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+      unsigned char *p = *args;
+      p++ ;
+      return ;
+    }
+ if(usart1.debug == 1)
+   {
+     usart1.printf(&usart1,"Device off\n");
+   }
+  GPIO_ResetBits(GPIOD, GPIO_Pin_3);
+}
+
+/**
+********************************************************************************
+* @function  void idle_hx8347a(unsigned char **args ,int arg_num)
+* @brief     Do nothing.
+*            Some object_lcd interface functions which HX8347A does not support,
+*            link to this function. (avoid idle function pointer)
+********************************************************************************
+**/
+static void idle_hx8347a(unsigned char **args ,int arg_num)
+{
+  /* variable (pointer) p is only used to avoid warning 'unused parameter'*/
+  unsigned char *p = *args;
+  int tmp = arg_num;
+  p++ ;
+  tmp++;
+ if(usart1.debug == 1)
+   {
+     usart1.printf(&usart1,"HX8347A does not support this function\n");
+   }
+}
+
+#if 0
+void DrewBitmap(void)
+{
+  ;
+}
+#endif
+
+
+/**
+********************************************************************************
+* @function  int get_lcd_index(object_ATcmd *at_cmd)
+* @brief     Get the lcd index in the array lcd_index
+* @return    count  --> the lcd index in lcd_index
+*            -1 --> fail
+********************************************************************************
+**/
+static int get_lcd_index(char *lcd_name)
+{
+  int count;
+  for(count = 0; count < MAX_LCD_INDEX_NUM ;count++)
+    {
+      /*check the first 7 chararcters*/
+      if( strncmp((const char*)lcd_name ,
+		  (const char*)&lcd_index[count] , 7) == 0)
+	{
+    	  return count;
+	}
+    }
+  return -1;
+}
+
+  /**
+********************************************************************************
+* @function  void set_device(unsigned char **args ,int arg_num)
+* @brief     Reset the LCD index in lcd_index[] 
+*            This need a global object_lcd variable 'global_lcd' .
+*            And it will reinitialize the LCD.
+********************************************************************************
+**/
+
+static void SetDevice(unsigned char **args ,int arg_num)
+{
+  unsigned char * lcd_name;
+  int index;
+  if(arg_num != 1)
+    {
+      return ;
+    }
+
+  lcd_name = *args;
+
+  index = get_lcd_index((char *)lcd_name);
+
+  if(index == -1)
+    {
+      if(usart1.debug == 1)
+	{
+	  usart1.printf(&usart1,"The '%s' is not support\n",lcd_name);
+	}
+      return ;
+    }
+  if(usart1.debug == 1)
+    {
+      usart1.printf(&usart1,"Set lcd_index to '%s'\n",lcd_name);
+    }
+  global_lcd.index = index;
+  object_lcd_init(&global_lcd);
+}
+
+/**
+********************************************************************************
+*  @function    int action_test(unsigned char **args, int arg_num)
+*  @brief       print the parameters in one command.
+*               Just for test.
+********************************************************************************
+**/
+static void action_test(unsigned char **args, int arg_num)
+{
+  int count;
+  if(usart1.debug == 1)
+    {
+      usart1.printf(&usart1,"This is object_lcd test action.\n");
+      if(arg_num == 0)
+	{
+	  usart1.printf(&usart1,"No parameter. \n");
+	}
+      for(count = 0; count < arg_num; count++)  
+	{
+	  usart1.printf(&usart1,"param %d = %s\n",count+1,*(args+count));
+	}
+    }
+}
+
+
+/**
+********************************************************************************
+*  @function    int object_lcd_init(object_lcd * lcd);
+*  @brief       Set up lcd object interface.
+*               Here , all the actions are link to their real functions.
+*  @return      return 0  --> succeed
+*               return -1 --> fail
+********************************************************************************
+**/
+int object_lcd_init(object_lcd * lcd)
+{
+  FSMC_Init();
+  LCD_DMA_Init();
+  bus_hook = _FlushPending;
+
+  switch(lcd->index)
+    {
+    case 0: /* HX8347A */
+    default:
+      display_x = lcd_index[0].x_size;
+      display_y = lcd_index[0].y_size;
+      clip.x1 = (int)display_x - 1;
+      clip.y1 = (int)display_y - 1;
+
+      lcd->lcd_init = LCD_Init_hx8347a;
+
+      lcd->set_contrast = idle_hx8347a;
+      lcd->set_brightness = idle_hx8347a;
+      lcd->set_display_page = idle_hx8347a;
+      lcd->write_page = idle_hx8347a;
+      break;
+    }
+
+  lcd->set_device = SetDevice;
+
+  lcd->get_lcd_Xsize = GetDisplayXSize_uart1;
+  lcd->get_lcd_Ysize = GetDisplayYSize_uart1;
+  lcd->device_on = DeviceOn;
+  lcd->device_off = DeviceOff;
+
+  lcd->clear_screen = ClearScreen;
+  lcd->fill_screen = FillScreen;
+  lcd->set_front_color = SetFrontColor;
+  lcd->get_front_color = GetFrontColor_uart1;
+  lcd->set_back_color = SetBackColor;
+  lcd->get_back_color = GetBackColor_uart1;
+  lcd->draw_point = DrawPoint;
+  lcd->draw_line = StrokeLine;
+  lcd->draw_rectangle = StrokeRect;
+  lcd->draw_cricle = StrokeCircle;
+  lcd->d_round_rectangle = StrokeRoundRect;
+  lcd->fill_rectangle = FillRectangle;
+  lcd->fill_cricle = FillCircle;
+  lcd->f_round_rectangle = FillRoundRect;
+  lcd->print_string = PrintString;
+  lcd->print_integer = PrintInteger;
+  lcd->print_float = PrintFloat;
+  lcd->set_font = SetFont;
+  lcd->get_font = GetFont_uart1;
+  lcd->get_font_Xsize = GetFontXSize_uart1; 
+  lcd->get_font_Ysize = GetFontYSize_uart1;
+  lcd->draw_bitmap = action_test;
+  lcd->get_statistics = GetStatistics_uart1;
+  lcd->set_text_mode = SetTextMode;
+  lcd->text_slot = TextSlot;
+  lcd->console_mode = ConsoleMode;
+  lcd->console_putc = ConsolePutc;
+  lcd->set_chart = SetChart;
+  lcd->chart_data = ChartData;
+  lcd->begin_frame = BeginFrame;
+  lcd->end_frame = EndFrame;
+  lcd->background = Background;
+  lcd->widget_create = WidgetCreate;
+  lcd->widget_set = WidgetSet;
+  lcd->widget_delete = WidgetDelete;
+  lcd->clip_push = ClipPush;
+  lcd->clip_pop = ClipPop;
+  lcd->fill_polygon = FillPolygon;
+  lcd->fill_triangle = FillTriangle;
+  lcd->draw_ellipse = DrawEllipse;
+  lcd->fill_ellipse = FillEllipse;
+  lcd->draw_arc = DrawArc;
+  lcd->fill_arc = FillArc;
+  lcd->quad_bezier = DrawQuadBezier;
+  lcd->cubic_bezier = DrawCubicBezier;
+  lcd->set_stroke = SetStroke;
+  lcd->anti_alias = SetAntiAlias;
+  lcd->fill_gradient = FillGradient;
+  lcd->set_brush = SetBrush;
+  lcd->upload_brush = UploadBrush;
+  lcd->read_pixels = ReadPixels_uart1;
+  lcd->copy_rect = CopyRect;
+
+  lcd->lcd_init((unsigned char **)0,0);
+  lcd->clear_screen((unsigned char **)0,0);
+  return 0;
+}
@@ -27,10 +27,15 @@
 *         Each action (function) in object_lcd has parameters 'args' & 'arg_num'.
 *         So other applicaitons can easily link to these functions.
 *         'args' contains the real parameters,
-*         'arg_num' is the parameters' number ,from 0 to 6.
+*         'arg_num' is the parameters' number ,from 0 to 33
+*         (MAX_ATCMD_PARAM in ATcmd_object.h).
 *         Some functions do not need parameters ,the arg_num can be 0.
 *         Some functions return values. The return value can be directly sent
 *         to UART ,or stored in memery or rewritten to the 'args' when needed.
+*         console_putc is not an action ,it takes the UART characters which
+*         are not AT commands (see console_mode).
+*         background is not an action ,the main loop calls it to finish the
+*         drawings kept back.
 ********************************************************************************
 **/
 
@@ -73,6 +78,37 @@ struct object_LCD
   void (*get_font_Xsize)(unsigned char **args,int arg_num);
   void (*get_font_Ysize)(unsigned char **args,int arg_num);
   void (*draw_bitmap)(unsigned char **args,int arg_num);
+  void (*get_statistics)(unsigned char **args,int arg_num);
+  void (*set_text_mode)(unsigned char **args,int arg_num);
+  void (*text_slot)(unsigned char **args,int arg_num);
+  void (*console_mode)(unsigned char **args,int arg_num);
+  void (*set_chart)(unsigned char **args,int arg_num);
+  void (*chart_data)(unsigned char **args,int arg_num);
+  void (*begin_frame)(unsigned char **args,int arg_num);
+  void (*end_frame)(unsigned char **args,int arg_num);
+  void (*widget_create)(unsigned char **args,int arg_num);
+  void (*widget_set)(unsigned char **args,int arg_num);
+  void (*widget_delete)(unsigned char **args,int arg_num);
+  void (*clip_push)(unsigned char **args,int arg_num);
+  void (*clip_pop)(unsigned char **args,int arg_num);
+  void (*fill_polygon)(unsigned char **args,int arg_num);
+  void (*fill_triangle)(unsigned char **args,int arg_num);
+  void (*draw_ellipse)(unsigned char **args,int arg_num);
+  void (*fill_ellipse)(unsigned char **args,int arg_num);
+  void (*draw_arc)(unsigned char **args,int arg_num);
+  void (*fill_arc)(unsigned char **args,int arg_num);
+  void (*quad_bezier)(unsigned char **args,int arg_num);
+  void (*cubic_bezier)(unsigned char **args,int arg_num);
+  void (*set_stroke)(unsigned char **args,int arg_num);
+  void (*anti_alias)(unsigned char **args,int arg_num);
+  void (*fill_gradient)(unsigned char **args,int arg_num);
+  void (*set_brush)(unsigned char **args,int arg_num);
+  void (*upload_brush)(unsigned char **args,int arg_num);
+  void (*read_pixels)(unsigned char **args,int arg_num);
+  void (*copy_rect)(unsigned char **args,int arg_num);
+
+  int (*console_putc)(unsigned char c);
+  void (*background)(void);
 };
 
 /**
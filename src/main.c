@@ -50,6 +50,7 @@ main(int argc, char* argv[])
       // Add your code here.
       at_command.get_cmd(&at_command);
       at_command.execute(&at_command);
+      global_lcd.background();
     }
 }
 